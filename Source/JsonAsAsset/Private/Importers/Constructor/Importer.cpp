@@ -11,12 +11,15 @@
 
 // Utilities
 #include "Utilities/AssetUtilities.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ImportDiagnostics.h"
+#include "Async/ParallelFor.h"
 
 #include "Misc/MessageDialog.h"
 #include "UObject/SavePackage.h"
 
-// Slate Icons
-#include "Styling/SlateIconFinder.h"
+// Slate
+#include "Framework/Application/SlateApplication.h"
 
 // ----> Importers
 #include "Importers/Types/CurveFloatImporter.h"
@@ -41,6 +44,8 @@
 // ----------------------- Templated Engine Classes
 #include "Sound/SoundNode.h"
 #include "Engine/SubsurfaceProfile.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
 #include "Materials/MaterialParameterCollection.h"
 #include "Curves/CurveLinearColor.h"
 #include "Logging/MessageLog.h"
@@ -60,7 +65,7 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 		FString Type = DataObject->GetStringField(TEXT("Type"));
 		FString Name = DataObject->GetStringField(TEXT("Name"));
 
-		UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type);
+		UClass* Class = FImportSession::Get().FindClass(Type);
 
 		if (Class == nullptr) continue;
 		bool bDataAsset = Class->IsChildOf(UDataAsset::StaticClass());
@@ -113,20 +118,10 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 						Importer = new UDataAssetImporter(Class, Name, File, DataObject, LocalPackage, LocalOutermostPkg, Exports);
 
 				else { // Templates handled here
-					UClass* LoadedClass = FindObject<UClass>(ANY_PACKAGE, *Type);
-
-					if (LoadedClass != nullptr) {
-						Importer = new TemplatedImporter<UObject>(LoadedClass, Name, File, DataObject, LocalPackage, LocalOutermostPkg, AllJsonObjects);
-					} else { // No template found
-						UE_LOG(LogTemp, Error, TEXT("Failed to load class for type: %s"), *Type);
-						
-						Importer = nullptr;
-					}
+					Importer = new TemplatedImporter<UObject>(Class, Name, File, DataObject, LocalPackage, LocalOutermostPkg, AllJsonObjects);
 				}
 			}
 
-			FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
-
 			if (bHideNotifications) {
 				Importer->ImportData();
 
@@ -139,27 +134,8 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 				if (!(Type == "AnimSequence" || Type == "AnimMontage"))
 					Importer->SavePackage();
 
-				// Notification for asset
-				AppendNotification(
-					FText::FromString("Imported type: " + Type),
-					FText::FromString(Name),
-					2.0f,
-					FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail")),
-					SNotificationItem::CS_Success,
-					false,
-					350.0f
-				);
-
-				MessageLogger.Message(EMessageSeverity::Info, FText::FromString("Imported Asset: " + Name + " (" + Type + ")"));
-			} else AppendNotification(
-				FText::FromString("Import Failed: " + Type),
-				FText::FromString(Name),
-				2.0f,
-				FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail")),
-				SNotificationItem::CS_Fail,
-				false,
-				350.0f
-			);
+				FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Imported, "Imported " + Type, Name);
+			} else FImportDiagnostics::Get().Error(EImportDiagnosticCategory::ImportFailed, "Import Failed: " + Type, Name);
 		}
 	}
 
@@ -169,10 +145,21 @@ bool IImporter::ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString Fi
 // This is called at the end of asset creation, bringing the user to the asset and fully loading it
 bool IImporter::HandleAssetCreation(UObject* Asset) const {
 	FAssetRegistryModule::AssetCreated(Asset);
+
+	// Anything that failed to resolve to this path before can now be found
+	FImportSession::Get().ForgetReference(Asset->GetPathName());
+
 	if (!Asset->MarkPackageDirty()) return false;
 	
 	Package->SetDirtyFlag(true);
-	Asset->PostEditChange();
+
+	// Materials are compiled together at the end of the import
+	if (UMaterialInterface* Material = Cast<UMaterialInterface>(Asset); Material && FImportSession::Get().IsDeferringMaterialUpdates()) {
+		FImportSession::Get().DeferMaterialUpdate(Material);
+	} else {
+		Asset->PostEditChange();
+	}
+
 	Asset->AddToRoot();
 	
 	Package->FullyLoad();
@@ -192,13 +179,17 @@ TObjectPtr<T> IImporter::DownloadWrapper(TObjectPtr<T> InObject, FString Type, F
 
 	// If the asset can be found locally
 	if (InObject == nullptr && ImportAssetReference(Path)) {
+		// Imported as a duplicate of another asset, which is used instead
+		if (UObject* Reused = nullptr; FImportSession::Get().FindReference(Path + "." + Name, Reused) && Reused != nullptr) {
+			return Cast<T>(Reused);
+		}
+
 		TObjectPtr<T> Object = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(Path + "." + Name)));
 
 		return Object;
 	}
 
 	bool bEnableLocalFetch = Settings->bEnableLocalFetch;
-	FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
 
 	if (bEnableLocalFetch && (
 		InObject == nullptr ||
@@ -211,35 +202,11 @@ TObjectPtr<T> IImporter::DownloadWrapper(TObjectPtr<T> InObject, FString Type, F
 		if (DefaultObject != nullptr) {
 			bool bRemoteDownloadStatus = false;
 
-			// Notification
 			if (FAssetUtilities::ConstructAsset(FSoftObjectPath(Type + "'" + Path + "." + Name + "'").ToString(), Type, InObject, bRemoteDownloadStatus)) {
-				const FText AssetNameText = FText::FromString(Name);
-				const FSlateBrush* IconBrush = FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, *("/Script/Engine." + Type)), TEXT("ClassThumbnail"));
-
 				if (bRemoteDownloadStatus) {
-					AppendNotification(
-						FText::FromString("Locally Downloaded: " + Type),
-						AssetNameText,
-						2.0f,
-						IconBrush,
-						SNotificationItem::CS_Success,
-						false,
-						310.0f
-					);
-
-					MessageLogger.Message(EMessageSeverity::Info, FText::FromString("Downloaded asset: " + Name + " (" + Type + ")"));
+					FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Download, "Locally Downloaded: " + Type, Name);
 				} else {
-					AppendNotification(
-						FText::FromString("Download Failed: " + Type),
-						AssetNameText,
-						5.0f,
-						IconBrush,
-						SNotificationItem::CS_Fail,
-						false,
-						310.0f
-					);
-
-					MessageLogger.Error(FText::FromString("Failed to download asset: " + Name + " (" + Type + ")"));
+					FImportDiagnostics::Get().Error(EImportDiagnosticCategory::Download, "Download Failed: " + Type, Name);
 				}
 			}
 		}
@@ -265,18 +232,20 @@ void IImporter::LoadObject(const TSharedPtr<FJsonObject>* PackageIndex, TObjectP
 	PackageIndex->Get()->GetStringField(TEXT("ObjectName")).Split("'", &ObjectType, &ObjectName);
 	PackageIndex->Get()->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr);
 
-	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
+	ObjectPath = NormalizeObjectPath(ObjectPath);
+	ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
 
-	// Rare case of needing a GameName
-	if (!Settings->AssetSettings.GameName.IsEmpty()) {
-		ObjectPath = ObjectPath.Replace(*(Settings->AssetSettings.GameName + "/Content"), TEXT("/Game"));
-	}
+	// Already resolved (or failed to resolve) during this import, objects of another class are loaded again as <T>
+	const FString ReferenceKey = ObjectPath + "." + ObjectName;
+	FImportSession& Session = FImportSession::Get();
 
-	ObjectPath = ObjectPath.Replace(TEXT("Engine/Content"), TEXT("/Engine"));
-	ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
+	if (UObject* CachedObject = nullptr; Session.FindReference(ReferenceKey, CachedObject) && (CachedObject == nullptr || CachedObject->IsA<T>())) {
+		Object = Cast<T>(CachedObject);
+		return;
+	}
 
 	// Try to load object using the object path and the object name combined
-	TObjectPtr<T> LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(ObjectPath + "." + ObjectName)));
+	TObjectPtr<T> LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *ReferenceKey));
 
 	// Material Expression case
 	if (!LoadedObject && ObjectName.Contains("MaterialExpression")) {
@@ -286,6 +255,24 @@ void IImporter::LoadObject(const TSharedPtr<FJsonObject>* PackageIndex, TObjectP
 	}
 
 	Object = DownloadWrapper(LoadedObject, ObjectType, ObjectName, ObjectPath);
+
+	// Don't replace an object of another class with a failed <T> lookup
+	if (UObject* CachedObject = nullptr; Object != nullptr || !Session.FindReference(ReferenceKey, CachedObject)) {
+		Session.AddReference(ReferenceKey, Object);
+	}
+}
+
+// Exported package path --> Path in this project
+FString IImporter::NormalizeObjectPath(const FString& ObjectPath) {
+	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
+	FString Path = ObjectPath;
+
+	// Rare case of needing a GameName
+	if (!Settings->AssetSettings.GameName.IsEmpty()) {
+		Path = Path.Replace(*(Settings->AssetSettings.GameName + "/Content"), TEXT("/Game"));
+	}
+
+	return Path.Replace(TEXT("Engine/Content"), TEXT("/Engine"));
 }
 
 // Loads an array of <T> object ptrs -------------------------------------------------------
@@ -296,31 +283,32 @@ TArray<TObjectPtr<T>> IImporter::LoadObject(const TArray<TSharedPtr<FJsonValue>>
 	for (const TSharedPtr<FJsonValue>& ArrayElement : PackageArray) {
 		const TSharedPtr<FJsonObject> ObjectPtr = ArrayElement->AsObject();
 
-		FString ObjectType, ObjectName, ObjectPath;
-		ObjectPtr->GetStringField(TEXT("ObjectName")).Split("'", &ObjectType, &ObjectName);
-		ObjectPtr->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr);
-		ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
-
-		TObjectPtr<T> LoadedObject = Cast<T>(StaticLoadObject(T::StaticClass(), nullptr, *(ObjectPath + "." + ObjectName)));
-		Array.Add(DownloadWrapper(LoadedObject, ObjectType, ObjectName, ObjectPath));
+		TObjectPtr<T> LoadedObject;
+		LoadObject(&ObjectPtr, LoadedObject);
+		Array.Add(LoadedObject);
 	}
 
 	return Array;
 }
 
-// Handles the import of an asset
-bool IImporter::ImportAssetReference(const FString& GamePath) {
+// Local JSON file of an asset, exported next to the file being imported
+FString IImporter::GetLocalReferencePath(const FString& GamePath) const {
 	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
 
 	FString UnSanitizedCodeName;
 	FilePath.Split(Settings->ExportDirectory.Path + "/", nullptr, &UnSanitizedCodeName);
 	UnSanitizedCodeName.Split("/", &UnSanitizedCodeName, nullptr, ESearchCase::IgnoreCase, ESearchDir::FromStart);
 
-	FString UnSanitizedPath = GamePath.Replace(TEXT("/Game/"), *(UnSanitizedCodeName + "/Content/"));
-	UnSanitizedPath = FPaths::Combine(Settings->ExportDirectory.Path, UnSanitizedPath + ".json");
+	const FString UnSanitizedPath = GamePath.Replace(TEXT("/Game/"), *(UnSanitizedCodeName + "/Content/"));
 
-	FString ContentBefore;
-	if (FFileHelper::LoadFileToString(ContentBefore, *UnSanitizedPath)) {
+	return FPaths::Combine(Settings->ExportDirectory.Path, UnSanitizedPath + ".json");
+}
+
+// Handles the import of an asset
+bool IImporter::ImportAssetReference(const FString& GamePath) {
+	const FString UnSanitizedPath = GetLocalReferencePath(GamePath);
+
+	if (FPaths::FileExists(UnSanitizedPath)) {
 		ImportReference(UnSanitizedPath);
 		return true;
 	}
@@ -328,11 +316,11 @@ bool IImporter::ImportAssetReference(const FString& GamePath) {
 	return false;
 }
 
-// Sends off to the ImportExports function once read
-void IImporter::ImportReference(const FString& File) {
+// Parses an exported file into its exports, safe to call from any thread
+bool IImporter::ReadExportsFile(const FString& File, TArray<TSharedPtr<FJsonValue>>& OutExports) {
 	/* ----  Parse JSON into UE JSON Reader ---- */
 	FString ContentBefore;
-	FFileHelper::LoadFileToString(ContentBefore, *File);
+	if (!FFileHelper::LoadFileToString(ContentBefore, *File)) return false;
 
 	FString Content = FString(TEXT("{\"data\": "));
 	Content.Append(ContentBefore);
@@ -342,13 +330,57 @@ void IImporter::ImportReference(const FString& File) {
 	const TSharedRef<TJsonReader<TCHAR>> JsonReader = TJsonReaderFactory<TCHAR>::Create(Content);
 	/* ---------------------------------------- */
 
-	if (FJsonSerializer::Deserialize(JsonReader, JsonParsed)) {
-		const TArray<TSharedPtr<FJsonValue>> DataObjects = JsonParsed->GetArrayField(TEXT("data"));
+	if (!FJsonSerializer::Deserialize(JsonReader, JsonParsed)) return false;
 
+	OutExports = JsonParsed->GetArrayField(TEXT("data"));
+	return true;
+}
+
+// Sends off to the ImportExports function once read
+void IImporter::ImportReference(const FString& File) {
+	FScopedImportSession ImportSession;
+
+	if (TArray<TSharedPtr<FJsonValue>> DataObjects; ReadExportsFile(File, DataObjects)) {
 		ImportExports(DataObjects, File);
 	}
 }
 
+// Imports many files, material instances are held back and imported together as a batch
+void IImporter::ImportReferences(const TArray<FString>& Files) {
+	FScopedImportSession ImportSession;
+
+	TArray<TArray<TSharedPtr<FJsonValue>>> FileExports;
+	FileExports.SetNum(Files.Num());
+
+	TArray<bool> bRead;
+	bRead.SetNumZeroed(Files.Num());
+
+	ParallelFor(Files.Num(), [&](const int32 Index) {
+		bRead[Index] = ReadExportsFile(Files[Index], FileExports[Index]);
+	});
+
+	TArray<FString> InstanceFiles;
+	TArray<TArray<TSharedPtr<FJsonValue>>> InstanceExports;
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		if (!bRead[Index]) continue;
+
+		if (UMaterialInstanceConstantImporter::IsInstanceFile(FileExports[Index])) {
+			InstanceFiles.Add(Files[Index]);
+			InstanceExports.Add(MoveTemp(FileExports[Index]));
+
+			continue;
+		}
+
+		ImportExports(FileExports[Index], Files[Index]);
+	}
+
+	// After everything else, so parents among the files exist
+	if (InstanceFiles.Num() > 0) {
+		UMaterialInstanceConstantImporter::ImportBatch(InstanceFiles, InstanceExports);
+	}
+}
+
 // Called before HandleAssetCreation, simply saves the asset if user opted
 void IImporter::SavePackage() {
 	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
@@ -365,6 +397,13 @@ void IImporter::SavePackage() {
 		return;
 	}
 
+	// Nothing was created in it, e.g. a duplicate reused from another path
+	UObject* Asset = Package->FindAssetInPackage();
+	if (Asset == nullptr) return;
+
+	// Deferred materials are saved once they are compiled, at the end of the session
+	if (FImportSession::Get().IsDeferringMaterialUpdates() && (Asset->IsA<UMaterial>() || Asset->IsA<UMaterialInstanceConstant>())) return;
+
 	const FString PackageName = Package->GetName();
 	const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageName, FPackageName::GetAssetPackageExtension());
 
@@ -380,6 +419,29 @@ bool IImporter::OnAssetCreation(UObject* Asset) {
 	return HandleAssetCreation(Asset);
 }
 
+bool IImporter::PatchExistingAsset(const UClass* AssetClass, const TSharedPtr<FJsonObject>& Properties) {
+	const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
+	if (!Settings->AssetSettings.bPatchExistingAssets || !Properties.IsValid()) return false;
+
+	UObject* Asset = StaticFindObjectFast(nullptr, Package, FName(FileName));
+	if (Asset == nullptr || !Asset->IsA(AssetClass)) return false;
+
+	const TArray<FString> ChangedPaths = GetObjectSerializer()->ApplyPropertyPatch(Properties, Asset);
+
+	if (ChangedPaths.Num() == 0) {
+		FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Patched, "Up to date", FileName);
+		return true;
+	}
+
+	FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Patched, "Patched: " + FString::Join(ChangedPaths, TEXT(", ")), FileName);
+
+	// Properties already received their own change events, skip the full PostEditChange of HandleAssetCreation
+	Asset->MarkPackageDirty();
+	SavePackage();
+
+	return true;
+}
+
 TSharedPtr<FJsonObject> IImporter::GetExport(FJsonObject* PackageIndex) {
 	FString ObjectName = PackageIndex->GetStringField(TEXT("ObjectName")); // Class'Asset:ExportName'
 	FString ObjectPath = PackageIndex->GetStringField(TEXT("ObjectPath")); // Path/Asset.Index
@@ -438,6 +500,9 @@ TSharedPtr<FJsonValue> IImporter::GetExportByObjectPath(const TSharedPtr<FJsonOb
 
 // Show the user a Notification
 void IImporter::AppendNotification(const FText& Text, const FText& SubText, float ExpireDuration, SNotificationItem::ECompletionState CompletionState, bool bUseSuccessFailIcons, float WidthOverride) {
+	// No UI to show it in (e.g. commandlets)
+	if (IsRunningCommandlet() || !FSlateApplication::IsInitialized()) return;
+
 	FNotificationInfo Info = FNotificationInfo(Text);
 	Info.ExpireDuration = ExpireDuration;
 	Info.bUseLargeFont = true;
@@ -451,6 +516,9 @@ void IImporter::AppendNotification(const FText& Text, const FText& SubText, floa
 
 // Show the user a Notification with Subtext
 void IImporter::AppendNotification(const FText& Text, const FText& SubText, float ExpireDuration, const FSlateBrush* SlateBrush, SNotificationItem::ECompletionState CompletionState, bool bUseSuccessFailIcons, float WidthOverride) {
+	// No UI to show it in (e.g. commandlets)
+	if (IsRunningCommandlet() || !FSlateApplication::IsInitialized()) return;
+
 	FNotificationInfo Info = FNotificationInfo(Text);
 	Info.ExpireDuration = ExpireDuration;
 	Info.bUseLargeFont = true;
@@ -2,6 +2,16 @@
 
 #include "Importers/Constructor/MaterialGraph.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ImportDiagnostics.h"
+#include "Async/ParallelFor.h"
+#include "Utilities/PropertyBinder.h"
+#include "UObject/UObjectIterator.h"
+#include "Settings/JsonAsAssetSettings.h"
+#include "RHIDefinitions.h"
+#include "Misc/SecureHash.h"
+#include "UObject/ObjectRedirector.h"
+#include "AssetRegistry/AssetRegistryModule.h"
 
 // Expressions
 #include "Materials/MaterialExpressionComment.h"
@@ -9,13 +19,18 @@
 #include "Materials/MaterialExpressionShadingPathSwitch.h"
 #include "Materials/MaterialExpressionQualitySwitch.h"
 #include "Materials/MaterialExpressionReroute.h"
+#include "Materials/MaterialExpressionNamedReroute.h"
+#include "Materials/MaterialExpressionFunctionInput.h"
+#include "Materials/MaterialExpressionFunctionOutput.h"
+#include "Materials/MaterialExpressionCustomOutput.h"
+#include "Materials/MaterialExpressionComposite.h"
+#include "Materials/MaterialExpressionPinBase.h"
+#include "Materials/MaterialFunction.h"
 
 #if ENGINE_MINOR_VERSION >= 5
 #include "Materials/MaterialExpressionTextureBase.h"
 #endif
 
-static TWeakPtr<SNotificationItem> MaterialGraphNotification;
-
 TSharedPtr<FJsonObject> IMaterialGraph::FindEditorOnlyData(const FString& Type, const FString& Outer, TMap<FName, FExportData>& OutExports, TArray<FName>& ExpressionNames, bool bFilterByOuter) {
 	TSharedPtr<FJsonObject> EditorOnlyData;
 
@@ -43,32 +58,551 @@ TSharedPtr<FJsonObject> IMaterialGraph::FindEditorOnlyData(const FString& Type,
 	return EditorOnlyData;
 }
 
-TMap<FName, UMaterialExpression*> IMaterialGraph::ConstructExpressions(UObject* Parent, const FString& Outer, TArray<FName>& ExpressionNames, TMap<FName, FExportData>& Exports) {
-	TMap<FName, UMaterialExpression*> CreatedExpressionMap;
+/* Expression Input Linking ------------------------------------------------------------------ */
+static const TPropertyBinder<FExpressionInput> ExpressionInputBinder = TPropertyBinder<FExpressionInput>()
+	.Bind(TEXT("OutputIndex"), &FExpressionInput::OutputIndex)
+	.Bind(TEXT("InputName"), &FExpressionInput::InputName)
+	.Bind(TEXT("Mask"), &FExpressionInput::Mask)
+	.Bind(TEXT("MaskR"), &FExpressionInput::MaskR)
+	.Bind(TEXT("MaskG"), &FExpressionInput::MaskG)
+	.Bind(TEXT("MaskB"), &FExpressionInput::MaskB)
+	.Bind(TEXT("MaskA"), &FExpressionInput::MaskA);
+
+static UScriptStruct* GetExpressionInputStruct() {
+	static UScriptStruct* ExpressionInputStruct = FindObject<UScriptStruct>(nullptr, TEXT("/Script/Engine.ExpressionInput"));
+	return ExpressionInputStruct;
+}
 
-	for (FName Name : ExpressionNames) {
-		FName Type;
-		FJsonObject* SharedRef = NULL;
-		bool bFound = false;
+class FExpressionInputSerializer : public FStructSerializer {
+	UPropertySerializer* PropertySerializer;
+	const TMap<FName, UMaterialExpression*>& Expressions;
+	const TMap<FName, TSharedPtr<FJsonObject>>& BypassedReroutes;
+	FFallbackStructSerializer Fallback;
+
+public:
+	FExpressionInputSerializer(UPropertySerializer* PropertySerializer, const TMap<FName, UMaterialExpression*>& Expressions, const TMap<FName, TSharedPtr<FJsonObject>>& BypassedReroutes)
+		: PropertySerializer(PropertySerializer), Expressions(Expressions), BypassedReroutes(BypassedReroutes), Fallback(PropertySerializer) {
+	}
+
+	virtual void Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) override {
+		Fallback.Serialize(Struct, JsonValue, StructData, OutReferencedSubobjects);
+	}
+
+	virtual void Deserialize(UScriptStruct* Struct, void* StructData, const TSharedPtr<FJsonObject> JsonValue) override {
+		FExpressionInput* Input = static_cast<FExpressionInput*>(StructData);
+		const FName ExpressionName = GetExpressionName(*JsonValue);
+
+		// Connected to a reroute that wasn't created, connect to what it passes through instead
+		if (const TSharedPtr<FJsonObject>* Source = BypassedReroutes.Find(ExpressionName)) {
+			DeserializeConstants(Struct, StructData, *JsonValue);
+			if (!Source->IsValid()) return;
+
+			Input->Expression = Expressions.FindRef(GetExpressionName(**Source));
+			ExpressionInputBinder.Apply(*Source, *Input);
+
+			// The pin keeps its own name
+			Input->InputName = NAME_None;
+
+			if (const TSharedPtr<FJsonValue>* InputName = JsonValue->Values.Find(TEXT("InputName")); InputName && InputName->IsValid()) {
+				JsonBinding::ReadValue(**InputName, Input->InputName);
+			}
+
+			return;
+		}
+
+		UMaterialExpression* Expression = Expressions.FindRef(ExpressionName);
+
+		// Not part of this graph, resolve it like any other reference
+		if (Expression == nullptr) {
+			Fallback.Deserialize(Struct, StructData, JsonValue);
+			return;
+		}
+
+		Input->Expression = Expression;
+
+		ExpressionInputBinder.Apply(JsonValue, *Input);
+		DeserializeConstants(Struct, StructData, *JsonValue);
+	}
+
+	virtual bool Compare(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, const TSharedPtr<FObjectCompareContext> Context) override {
+		return Fallback.Compare(Struct, JsonValue, StructData, Context);
+	}
+
+private:
+	// Material inputs add a constant on top of the expression input (e.g. UseConstant and Constant of FColorMaterialInput)
+	void DeserializeConstants(UScriptStruct* Struct, void* StructData, const FJsonObject& JsonValue) const {
+		for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+			if (Property->GetOwnerStruct() == GetExpressionInputStruct() || !PropertySerializer->ShouldSerializeProperty(Property)) continue;
+
+			if (const TSharedPtr<FJsonValue>* Value = JsonValue.Values.Find(Property->GetName()); Value && Value->IsValid()) {
+				PropertySerializer->DeserializePropertyValue(Property, Value->ToSharedRef(), Property->ContainerPtrToValuePtr<void>(StructData));
+			}
+		}
+	}
+
+	static FName GetExpressionName(const FJsonObject& JsonValue) {
+		const TSharedPtr<FJsonValue>* ExpressionField = JsonValue.Values.Find(TEXT("Expression"));
+		if (ExpressionField == nullptr || !ExpressionField->IsValid() || (*ExpressionField)->Type != EJson::Object) return NAME_None;
+
+		// Class'Asset:ExportName' --> ExportName
+		FString Name;
+		if (!(*ExpressionField)->AsObject()->TryGetStringField(TEXT("ObjectName"), Name)) return NAME_None;
+
+		Name.Split("'", nullptr, &Name);
+		Name.Split(":", nullptr, &Name);
+		Name = Name.Replace(TEXT("'"), TEXT(""));
+
+		return FName(*Name);
+	}
+};
+
+FScopedExpressionInputLinking::FScopedExpressionInputLinking(UPropertySerializer* PropertySerializer, const TMap<FName, UMaterialExpression*>& Expressions, const TMap<FName, TSharedPtr<FJsonObject>>& BypassedReroutes)
+	: PropertySerializer(PropertySerializer) {
+	static TArray<UScriptStruct*> ExpressionInputStructs;
+
+	if (ExpressionInputStructs.IsEmpty() && GetExpressionInputStruct() != nullptr) {
+		for (TObjectIterator<UScriptStruct> It; It; ++It) {
+			if (It->IsChildOf(GetExpressionInputStruct())) ExpressionInputStructs.Add(*It);
+		}
+	}
+
+	const TSharedPtr<FStructSerializer> Serializer = MakeShared<FExpressionInputSerializer>(PropertySerializer, Expressions, BypassedReroutes);
+
+	for (UScriptStruct* Struct : ExpressionInputStructs) {
+		PropertySerializer->AddStructSerializer(Struct, Serializer);
+		Structs.Add(Struct);
+	}
+}
+
+FScopedExpressionInputLinking::~FScopedExpressionInputLinking() {
+	for (UScriptStruct* Struct : Structs) {
+		PropertySerializer->RemoveStructSerializer(Struct);
+	}
+}
+
+// Adds the game path of the function a function call expression references, normalized the same way references are loaded
+static void CollectMaterialFunctionPath(const FJsonObject* Export, TArray<FString>& OutPaths) {
+	if (FString Type; !Export->TryGetStringField(TEXT("Type"), Type) || Type != "MaterialExpressionMaterialFunctionCall") return;
+
+	const TSharedPtr<FJsonObject>* Properties;
+	const TSharedPtr<FJsonObject>* MaterialFunction;
+	if (!Export->TryGetObjectField(TEXT("Properties"), Properties) || !Properties->Get()->TryGetObjectField(TEXT("MaterialFunction"), MaterialFunction)) return;
+
+	if (FString ObjectPath; MaterialFunction->Get()->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr)) {
+		OutPaths.AddUnique(IImporter::NormalizeObjectPath(ObjectPath));
+	}
+}
+
+void IMaterialGraph::PrefetchMaterialFunctions(const TMap<FName, FExportData>& Exports) {
+	struct FFunctionFile {
+		FString File;
+		TArray<TSharedPtr<FJsonValue>> Exports;
+		TArray<FString> Dependencies;
+	};
+
+	TArray<FString> Pending;
+	for (const TPair<FName, FExportData>& Export : Exports) {
+		CollectMaterialFunctionPath(Export.Value.Json, Pending);
+	}
+
+	// Game path -> Parsed file, for each function that has to be imported
+	TMap<FString, FFunctionFile> Files;
+	TSet<FString> Visited;
+
+	// Resolve the whole closure one level at a time, each level is read and parsed in parallel
+	while (Pending.Num() > 0) {
+		TArray<FString> Level;
+
+		for (const FString& Path : Pending) {
+			bool bAlreadyVisited = false;
+			Visited.Add(Path, &bAlreadyVisited);
+
+			// Already loaded, or saved in the project
+			if (bAlreadyVisited || FindPackage(nullptr, *Path) || FPackageName::DoesPackageExist(Path)) continue;
+
+			Level.Add(Path);
+		}
+
+		Pending.Reset();
+
+		TArray<FFunctionFile> Parsed;
+		Parsed.SetNum(Level.Num());
+
+		ParallelFor(Level.Num(), [&](const int32 Index) {
+			FFunctionFile& Function = Parsed[Index];
+			Function.File = GetLocalReferencePath(Level[Index]);
+
+			if (!ReadExportsFile(Function.File, Function.Exports)) return;
+
+			for (const TSharedPtr<FJsonValue>& Value : Function.Exports) {
+				CollectMaterialFunctionPath(Value->AsObject().Get(), Function.Dependencies);
+			}
+		});
+
+		for (int32 Index = 0; Index < Level.Num(); Index++) {
+			if (Parsed[Index].Exports.IsEmpty()) continue;
+
+			Pending.Append(Parsed[Index].Dependencies);
+			Files.Add(Level[Index], MoveTemp(Parsed[Index]));
+		}
+	}
+
+	// Functions are imported after the functions they call
+	TSet<FString> Imported;
+
+	TFunction<void(const FString&)> Import = [&](const FString& Path) {
+		bool bAlreadyImported = false;
+		Imported.Add(Path, &bAlreadyImported);
+
+		const FFunctionFile* Function = Files.Find(Path);
+		if (bAlreadyImported || Function == nullptr) return;
+
+		for (const FString& Dependency : Function->Dependencies) {
+			Import(Dependency);
+		}
+
+		ImportExports(Function->Exports, Function->File);
+	};
+
+	for (const TPair<FString, FFunctionFile>& Function : Files) {
+		Import(Function.Key);
+	}
+}
+
+// Adds the object name of every expression an input connects to, inputs can be nested in structs and arrays
+static void CollectExpressionInputs(const FJsonObject& Object, TArray<FString>& OutObjectNames);
+
+static void CollectExpressionInputs(const FJsonValue& Value, TArray<FString>& OutObjectNames) {
+	if (Value.Type == EJson::Object) {
+		CollectExpressionInputs(*Value.AsObject(), OutObjectNames);
+	} else if (Value.Type == EJson::Array) {
+		for (const TSharedPtr<FJsonValue>& Element : Value.AsArray()) {
+			if (Element.IsValid()) CollectExpressionInputs(*Element, OutObjectNames);
+		}
+	}
+}
+
+static void CollectExpressionInputs(const FJsonObject& Object, TArray<FString>& OutObjectNames) {
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values) {
+		if (!Field.Value.IsValid()) continue;
+
+		if (Field.Key == TEXT("Expression") && Field.Value->Type == EJson::Object) {
+			if (FString ObjectName; Field.Value->AsObject()->TryGetStringField(TEXT("ObjectName"), ObjectName)) OutObjectNames.Add(ObjectName);
+
+			continue;
+		}
+
+		CollectExpressionInputs(*Field.Value, OutObjectNames);
+	}
+}
+
+FMaterialGraphIR IMaterialGraph::BuildGraphIR(const FString& Outer, const TArray<FName>& ExpressionNames, const TMap<FName, FExportData>& Exports) {
+	FMaterialGraphIR Graph;
+	Graph.Expressions.SetNum(ExpressionNames.Num());
+
+	TArray<TArray<FString>> Errors;
+	Errors.SetNum(ExpressionNames.Num());
+
+	// Only reads the JSON, so every expression is parsed on its own worker
+	ParallelFor(ExpressionNames.Num(), [&](const int32 Index) {
+		FMaterialExpressionIR& Expression = Graph.Expressions[Index];
+		Expression.Name = ExpressionNames[Index];
+
+		const FExportData* Export = Exports.Find(Expression.Name);
+		if (Export == nullptr) return;
+
+		Expression.Type = Export->Type;
+		Expression.Export = Export->Json;
+
+		const TSharedPtr<FJsonObject>* Properties;
+		if (!Export->Json->TryGetObjectField(TEXT("Properties"), Properties)) {
+			Errors[Index].Add(Expression.Name.ToString() + " has no properties");
+			return;
+		}
+
+		Expression.Properties = Properties->Get();
+
+		if (FString ParameterName; Expression.Properties->TryGetStringField(TEXT("ParameterName"), ParameterName)) {
+			Expression.ParameterName = FName(*ParameterName);
+		}
+
+		if (const TSharedPtr<FJsonObject>* MaterialFunction; Expression.Properties->TryGetObjectField(TEXT("MaterialFunction"), MaterialFunction)) {
+			MaterialFunction->Get()->GetStringField(TEXT("ObjectPath")).Split(".", &Expression.FunctionPath, nullptr);
+		}
+
+		TArray<FString> InputObjectNames;
+		CollectExpressionInputs(*Expression.Properties, InputObjectNames);
+
+		for (const FString& ObjectName : InputObjectNames) {
+			// Class'Asset:ExportName', references outside of this asset are resolved like any other object
+			FString AssetName, InputName = ObjectName;
+			InputName.Split("'", nullptr, &InputName);
+			InputName = InputName.Replace(TEXT("'"), TEXT(""));
+
+			if (!InputName.Split(":", &AssetName, &InputName)) continue;
+			AssetName.Split(".", nullptr, &AssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+
+			const FName Input(*InputName);
+
+			if (AssetName == Outer && !Exports.Contains(Input)) {
+				Errors[Index].Add(Expression.Name.ToString() + " is connected to missing expression " + InputName);
+				continue;
+			}
+
+			Expression.Inputs.AddUnique(Input);
+		}
+	});
+
+	Graph.ExpressionIndices.Reserve(ExpressionNames.Num());
+
+	for (int32 Index = 0; Index < Graph.Expressions.Num(); Index++) {
+		Graph.ExpressionIndices.Add(Graph.Expressions[Index].Name, Index);
+		Graph.Errors.Append(Errors[Index]);
+	}
+
+	return Graph;
+}
+
+bool IMaterialGraph::ValidateGraphIR(const FMaterialGraphIR& Graph) const {
+	for (const FString& Error : Graph.Errors) {
+		FImportDiagnostics::Get().Error(EImportDiagnosticCategory::InvalidData, Error, FileName);
+	}
+
+	return Graph.IsValid();
+}
+
+/* Graph Hashing ----------------------------------------------------------------------------- */
+// Identify a copy, not its structure
+static const TSet<FString> UnhashedFields = {
+	TEXT("StateId"),
+	TEXT("LightingGuid"),
+	TEXT("MaterialExpressionGuid")
+};
+
+static void HashString(FSHA1& Hash, const FString& String) {
+	const FTCHARToUTF8 Converted(*String);
+
+	Hash.Update(reinterpret_cast<const uint8*>(Converted.Get()), Converted.Length() + 1);
+}
+
+// The asset being hashed, only exact references to it are canonicalized
+struct FGraphHashContext {
+	FString AssetName;
+
+	// e.g. /Game/Characters/M_Skin
+	FString PackageName;
+
+	bool IsSelfPath(FString ObjectPath) const {
+		// Exported paths use the game's content folder instead of the mount point, normalized the same way references are loaded
+		ObjectPath.Split(".", &ObjectPath, nullptr);
+		ObjectPath = IImporter::NormalizeObjectPath(ObjectPath);
+
+		if (!ObjectPath.StartsWith("/")) ObjectPath = "/" + ObjectPath;
+		ObjectPath.ReplaceInline(TEXT("//"), TEXT("/"));
+
+		return ObjectPath.Equals(PackageName, ESearchCase::IgnoreCase);
+	}
+};
+
+static void HashJsonValue(FSHA1& Hash, const FJsonValue& Value, const FGraphHashContext& Context) {
+	const uint8 Type = static_cast<uint8>(Value.Type);
+	Hash.Update(&Type, sizeof(Type));
+
+	switch (Value.Type) {
+		case EJson::String:
+			HashString(Hash, Value.AsString());
+			break;
+
+		case EJson::Number: {
+			const double Number = Value.AsNumber();
+			Hash.Update(reinterpret_cast<const uint8*>(&Number), sizeof(Number));
+			break;
+		}
+
+		case EJson::Boolean: {
+			const uint8 bValue = Value.AsBool();
+			Hash.Update(&bValue, sizeof(bValue));
+			break;
+		}
+
+		case EJson::Array: {
+			const TArray<TSharedPtr<FJsonValue>>& Array = Value.AsArray();
+
+			const int32 Num = Array.Num();
+			Hash.Update(reinterpret_cast<const uint8*>(&Num), sizeof(Num));
+
+			for (const TSharedPtr<FJsonValue>& Element : Array) {
+				if (Element.IsValid()) HashJsonValue(Hash, *Element, Context);
+			}
+
+			break;
+		}
+
+		case EJson::Object: {
+			const TSharedPtr<FJsonObject> Object = Value.AsObject();
+
+			// References to this asset only keep the export name, the path differs between copies
+			FString ObjectName, ObjectPath;
+			if (Object->TryGetStringField(TEXT("ObjectName"), ObjectName) && Object->TryGetStringField(TEXT("ObjectPath"), ObjectPath)) {
+				if (Context.IsSelfPath(ObjectPath)) {
+					// Class'Asset:ExportName' --> ExportName
+					ObjectName.Split(":", nullptr, &ObjectName);
+
+					HashString(Hash, TEXT("$Asset:") + ObjectName.Replace(TEXT("'"), TEXT("")));
+					break;
+				}
+			}
+
+			// Exported key order isn't guaranteed
+			TArray<FString> Keys;
+			Object->Values.GetKeys(Keys);
+			Keys.Sort();
 
-		for (TTuple<FName, FExportData>& Key : Exports) {
-			TSharedPtr<FJsonObject>* SharedO = new TSharedPtr<FJsonObject>(Key.Value.Json);
+			for (const FString& Key : Keys) {
+				const TSharedPtr<FJsonValue>& Field = Object->Values[Key];
+				if (!Field.IsValid() || UnhashedFields.Contains(Key)) continue;
 
-			if (Key.Key == Name && Key.Value.Outer == FName(*Outer)) {
-				Type = Key.Value.Type;
-				SharedRef = SharedO->Get();
+				HashString(Hash, Key);
 
-				bFound = true;
-				break;
+				// An export's own name, or its outer being the asset, are the only other places the name is canonical
+				if ((Key == TEXT("Name") || Key == TEXT("Outer")) && Field->Type == EJson::String && Field->AsString() == Context.AssetName) {
+					const uint8 StringType = static_cast<uint8>(EJson::String);
+					Hash.Update(&StringType, sizeof(StringType));
+					HashString(Hash, TEXT("$Asset"));
+
+					continue;
+				}
+
+				HashJsonValue(Hash, *Field, Context);
 			}
+
+			break;
+		}
+
+		default:
+			break;
+	}
+}
+
+FString IMaterialGraph::HashMaterialGraph() const {
+	FGraphHashContext Context;
+	Context.AssetName = FileName;
+
+	Context.PackageName = OutermostPkg->GetName();
+
+	FSHA1 Hash;
+
+	for (const TSharedPtr<FJsonValue>& Export : AllJsonObjects) {
+		if (Export.IsValid()) HashJsonValue(Hash, *Export, Context);
+	}
+
+	Hash.Final();
+
+	FSHAHash Result;
+	Hash.GetHash(Result.Hash);
+
+	return Result.ToString();
+}
+
+bool IMaterialGraph::HandleDuplicateGraph(FString& OutGraphHash) {
+	const EMaterialDeduplication Deduplication = GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings.Deduplication;
+	if (Deduplication == EMaterialDeduplication::Disabled) return false;
+
+	OutGraphHash = HashMaterialGraph();
+
+	UObject* Canonical = FImportSession::Get().FindCanonicalGraph(OutGraphHash);
+	if (Canonical == nullptr) return false;
+
+	// Messages are merged by text, so each group is listed once with all of its copies
+	FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Duplicate, "Same graph as " + Canonical->GetPathName(), FileName);
+
+	switch (Deduplication) {
+		case EMaterialDeduplication::Redirect: {
+			UObjectRedirector* Redirector = NewObject<UObjectRedirector>(OutermostPkg, *FileName, RF_Standalone | RF_Public);
+			Redirector->DestinationObject = Canonical;
+
+			FAssetRegistryModule::AssetCreated(Redirector);
+			Redirector->MarkPackageDirty();
+
+			SavePackage();
+
+			return true;
+		}
+
+		case EMaterialDeduplication::Reuse:
+			FImportSession::Get().AddReference(OutermostPkg->GetName() + "." + FileName, Canonical);
+
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+void IMaterialGraph::PrepareLeanImport(FMaterialGraphIR& Graph, const TMap<FName, FExportData>& Exports) {
+	UPropertySerializer* PropertySerializer = GetObjectSerializer()->GetPropertySerializer();
+	PropertySerializer->DisablePropertySerialization(UMaterialExpression::StaticClass(), GET_MEMBER_NAME_CHECKED(UMaterialExpression, MaterialExpressionEditorX));
+	PropertySerializer->DisablePropertySerialization(UMaterialExpression::StaticClass(), GET_MEMBER_NAME_CHECKED(UMaterialExpression, MaterialExpressionEditorY));
+
+	// Reroutes acting as pins of composite nodes are needed to build the subgraph
+	TSet<FName> PinReroutes;
+
+	for (const TPair<FName, FExportData>& Export : Exports) {
+		if (Export.Value.Type != "MaterialExpressionPinBase") continue;
+
+		const TArray<TSharedPtr<FJsonValue>>* ReroutePins;
+		if (!Export.Value.Json->GetObjectField(TEXT("Properties"))->TryGetArrayField(TEXT("ReroutePins"), ReroutePins)) continue;
+
+		for (const TSharedPtr<FJsonValue>& ReroutePin : *ReroutePins) {
+			if (ReroutePin->IsNull()) continue;
+
+			PinReroutes.Add(GetExpressionName(ReroutePin->AsObject().Get()));
 		}
+	}
+
+	// Reroute --> The input it passes through, usages pass through their declaration
+	TMap<FName, FName> Usages;
+
+	for (const FMaterialExpressionIR& Expression : Graph.Expressions) {
+		if (Expression.Properties == nullptr || PinReroutes.Contains(Expression.Name) || Expression.Properties->HasField(TEXT("SubgraphExpression"))) continue;
 
-		if (!bFound) continue;
-		UMaterialExpression* Ex = CreateEmptyExpression(Parent, Name, Type, SharedRef);
+		if (Expression.Type == "MaterialExpressionReroute" || Expression.Type == "MaterialExpressionNamedRerouteDeclaration") {
+			const TSharedPtr<FJsonObject>* Input;
+			Graph.BypassedReroutes.Add(Expression.Name, Expression.Properties->TryGetObjectField(TEXT("Input"), Input) ? *Input : nullptr);
+		} else if (Expression.Type == "MaterialExpressionNamedRerouteUsage") {
+			Usages.Add(Expression.Name, GetExpressionName(Expression.Properties, "Declaration"));
+		}
+	}
+
+	for (const TPair<FName, FName>& Usage : Usages) {
+		if (const TSharedPtr<FJsonObject>* Declaration = Graph.BypassedReroutes.Find(Usage.Value)) {
+			Graph.BypassedReroutes.Add(Usage.Key, *Declaration);
+		}
+	}
+
+	// Follow reroutes connected to reroutes, until the input reaches a created expression
+	for (TPair<FName, TSharedPtr<FJsonObject>>& Reroute : Graph.BypassedReroutes) {
+		for (int32 Depth = 0; Reroute.Value.IsValid() && Depth < Graph.BypassedReroutes.Num(); Depth++) {
+			const TSharedPtr<FJsonObject>* Source = Graph.BypassedReroutes.Find(GetExpressionName(Reroute.Value.Get()));
+			if (Source == nullptr) break;
+
+			Reroute.Value = *Source;
+		}
+	}
+}
+
+TMap<FName, UMaterialExpression*> IMaterialGraph::ConstructExpressions(UObject* Parent, const FMaterialGraphIR& Graph) {
+	TMap<FName, UMaterialExpression*> CreatedExpressionMap;
+	CreatedExpressionMap.Reserve(Graph.Expressions.Num());
+
+	for (const FMaterialExpressionIR& Expression : Graph.Expressions) {
+		if (Expression.Export == nullptr || Graph.BypassedReroutes.Contains(Expression.Name)) continue;
+
+		UMaterialExpression* Ex = CreateEmptyExpression(Parent, Expression.Name, Expression.Type, Expression.Export);
 		if (Ex == nullptr)
 			continue;
 
-		CreatedExpressionMap.Add(Name, Ex);
+		CreatedExpressionMap.Add(Expression.Name, Ex);
 	}
 
 	return CreatedExpressionMap;
@@ -200,6 +734,173 @@ void IMaterialGraph::PropagateExpressions(UObject* Parent, TArray<FName>& Expres
 	}
 }
 
+static FMaterialExpressionCollection& GetExpressionCollection(UObject* Parent) {
+	if (UMaterialFunction* MaterialFunction = Cast<UMaterialFunction>(Parent)) return MaterialFunction->GetExpressionCollection();
+
+	return CastChecked<UMaterial>(Parent)->GetExpressionCollection();
+}
+
+// Calls Visit with every input of the graph, the material's own inputs included
+static void ForEachGraphInput(UObject* Parent, TFunctionRef<void(FExpressionInput&)> Visit) {
+	if (UMaterial* Material = Cast<UMaterial>(Parent)) {
+		TSet<FExpressionInput*> MaterialInputs;
+
+		for (int32 Property = 0; Property < MP_MAX; Property++) {
+			FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(Property));
+			if (Input == nullptr || MaterialInputs.Contains(Input)) continue;
+
+			MaterialInputs.Add(Input);
+			Visit(*Input);
+		}
+	}
+
+	for (UMaterialExpression* Expression : GetExpressionCollection(Parent).Expressions) {
+		if (Expression == nullptr) continue;
+
+		for (int32 Index = 0; FExpressionInput* Input = Expression->GetInput(Index); Index++) {
+			Visit(*Input);
+		}
+	}
+}
+
+// Expressions that count as used even if nothing reads from them
+static bool IsRootExpression(const UMaterialExpression* Expression) {
+	return Expression->IsA<UMaterialExpressionFunctionOutput>()
+		|| Expression->IsA<UMaterialExpressionFunctionInput>()
+		|| Expression->IsA<UMaterialExpressionCustomOutput>()
+		|| Expression->IsA<UMaterialExpressionComposite>()
+		|| Expression->IsA<UMaterialExpressionPinBase>();
+}
+
+// Every expression the outputs of the graph read from
+static TSet<UMaterialExpression*> FindUsedExpressions(UObject* Parent) {
+	TSet<UMaterialExpression*> Used;
+	TArray<UMaterialExpression*> Stack;
+
+	auto Push = [&Used, &Stack](UMaterialExpression* Expression) {
+		if (Expression == nullptr || Used.Contains(Expression)) return;
+
+		Used.Add(Expression);
+		Stack.Add(Expression);
+	};
+
+	if (UMaterial* Material = Cast<UMaterial>(Parent)) {
+		for (int32 Property = 0; Property < MP_MAX; Property++) {
+			if (const FExpressionInput* Input = Material->GetExpressionInputForProperty(static_cast<EMaterialProperty>(Property))) Push(Input->Expression);
+		}
+	}
+
+	for (UMaterialExpression* Expression : GetExpressionCollection(Parent).Expressions) {
+		if (Expression != nullptr && IsRootExpression(Expression)) Push(Expression);
+	}
+
+	while (Stack.Num() > 0) {
+		UMaterialExpression* Expression = Stack.Pop();
+
+		for (int32 Index = 0; const FExpressionInput* Input = Expression->GetInput(Index); Index++) {
+			Push(Input->Expression);
+		}
+
+		// Named reroutes read from their declaration without a pin
+		if (const UMaterialExpressionNamedRerouteUsage* Usage = Cast<UMaterialExpressionNamedRerouteUsage>(Expression)) {
+			Push(Usage->Declaration);
+		}
+	}
+
+	return Used;
+}
+
+// The input a switch passes through for the chosen branch, null if the expression isn't a switch
+static const FExpressionInput* GetCollapsedSwitchBranch(UMaterialExpression* Expression, const FMaterialImportSettings& Settings) {
+	auto Choose = [](const FExpressionInput& Branch, const FExpressionInput& Default) {
+		return Branch.Expression != nullptr ? &Branch : &Default;
+	};
+
+	if (const UMaterialExpressionQualitySwitch* QualitySwitch = Cast<UMaterialExpressionQualitySwitch>(Expression)) {
+		// Num is a valid value of the enum, config files can hold anything
+		const int32 QualityLevel = FMath::Clamp<int32>(Settings.CollapsedQualityLevel, 0, EMaterialQualityLevel::Num - 1);
+
+		return Choose(QualitySwitch->Inputs[QualityLevel], QualitySwitch->Default);
+	}
+
+	if (const UMaterialExpressionFeatureLevelSwitch* FeatureLevelSwitch = Cast<UMaterialExpressionFeatureLevelSwitch>(Expression)) {
+		ERHIFeatureLevel::Type FeatureLevel = ERHIFeatureLevel::SM5;
+
+		switch (Settings.CollapsedFeatureLevel) {
+			case EImportFeatureLevel::ES3_1: FeatureLevel = ERHIFeatureLevel::ES3_1; break;
+			case EImportFeatureLevel::SM5: FeatureLevel = ERHIFeatureLevel::SM5; break;
+			case EImportFeatureLevel::SM6: FeatureLevel = ERHIFeatureLevel::SM6; break;
+		}
+
+		return Choose(FeatureLevelSwitch->Inputs[FeatureLevel], FeatureLevelSwitch->Default);
+	}
+
+	if (const UMaterialExpressionShadingPathSwitch* ShadingPathSwitch = Cast<UMaterialExpressionShadingPathSwitch>(Expression)) {
+		ERHIShadingPath::Type ShadingPath = ERHIShadingPath::Deferred;
+
+		switch (Settings.CollapsedShadingPath) {
+			case EImportShadingPath::Deferred: ShadingPath = ERHIShadingPath::Deferred; break;
+			case EImportShadingPath::Forward: ShadingPath = ERHIShadingPath::Forward; break;
+			case EImportShadingPath::Mobile: ShadingPath = ERHIShadingPath::Mobile; break;
+		}
+
+		return Choose(ShadingPathSwitch->Inputs[ShadingPath], ShadingPathSwitch->Default);
+	}
+
+	return nullptr;
+}
+
+static void RemoveExpression(UObject* Parent, UMaterialExpression* Expression) {
+	GetExpressionCollection(Parent).RemoveExpression(Expression);
+
+	if (UMaterial* Material = Cast<UMaterial>(Parent)) {
+		Material->RemoveExpressionParameter(Expression);
+	}
+
+	Expression->MarkAsGarbage();
+}
+
+void IMaterialGraph::CollapseMaterialSwitches(UObject* Parent) {
+	const FMaterialImportSettings& Settings = GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings;
+
+	TMap<UMaterialExpression*, FExpressionInput> Branches;
+
+	for (UMaterialExpression* Expression : GetExpressionCollection(Parent).Expressions) {
+		if (const FExpressionInput* Branch = GetCollapsedSwitchBranch(Expression, Settings)) {
+			Branches.Add(Expression, *Branch);
+		}
+	}
+
+	if (Branches.Num() == 0) return;
+
+	const TSet<UMaterialExpression*> UsedBefore = FindUsedExpressions(Parent);
+
+	// Read straight from the chosen branch, following switches connected to switches
+	ForEachGraphInput(Parent, [&Branches](FExpressionInput& Input) {
+		for (int32 Depth = 0; Depth < Branches.Num(); Depth++) {
+			const FExpressionInput* Branch = Branches.Find(Input.Expression);
+			if (Branch == nullptr) return;
+
+			const FName InputName = Input.InputName;
+			Input = *Branch;
+			Input.InputName = InputName;
+		}
+	});
+
+	// Only remove what the switches kept alive, unconnected expressions stay as they were
+	const TSet<UMaterialExpression*> UsedAfter = FindUsedExpressions(Parent);
+	int32 RemovedCount = 0;
+
+	for (UMaterialExpression* Expression : UsedBefore) {
+		if (UsedAfter.Contains(Expression)) continue;
+
+		RemoveExpression(Parent, Expression);
+		RemovedCount++;
+	}
+
+	UE_LOG(LogJson, Log, TEXT("%s: collapsed %d material switches, removed %d expressions"), *Parent->GetName(), Branches.Num(), RemovedCount);
+}
+
 void IMaterialGraph::MaterialGraphNode_ConstructComments(UObject* Parent, const TSharedPtr<FJsonObject>& Json, TMap<FName, FExportData>& Exports) {
 	if (const TArray<TSharedPtr<FJsonValue>>* StringExpressionComments; Json->TryGetArrayField("EditorComments", StringExpressionComments))
 		// Iterate through comments
@@ -221,9 +922,8 @@ void IMaterialGraph::MaterialGraphNode_ConstructComments(UObject* Parent, const
 		}
 
 	for (TTuple<FString, FJsonObject*>& Key : MissingNodeClasses) {
-		TSharedPtr<FJsonObject>* SharedObject = new TSharedPtr<FJsonObject>(Key.Value);
-
-		const TSharedPtr<FJsonObject> Properties = SharedObject->Get()->GetObjectField("Properties");
+		// Owned by the export it came from, so it isn't wrapped in a shared pointer of its own
+		const TSharedPtr<FJsonObject> Properties = Key.Value->GetObjectField("Properties");
 		UMaterialExpressionComment* Comment = NewObject<UMaterialExpressionComment>(Parent, UMaterialExpressionComment::StaticClass(), *("UMaterialExpressionComment_" + Key.Key), RF_Transactional);
 
 		Comment->Text = *("Missing Node Class " + Key.Key);
@@ -257,44 +957,19 @@ UMaterialExpression* IMaterialGraph::CreateEmptyExpression(UObject* Parent, FNam
 	if (IgnoredExpressions.Contains(Type.ToString())) // Unhandled expressions
 		return nullptr;
 
-	const UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString());
+	// Redirected and renamed classes are handled by the resolver, misses included
+	const UClass* Class = FImportSession::Get().FindExpressionClass(Type.ToString());
 
+	// Show missing nodes in graph, and report them once the import is done
 	if (!Class) {
-		TArray<FString> Redirects = TArray{
-			FLinkerLoad::FindNewPathNameForClass("/Script/InterchangeImport." + Type.ToString(), false),
-			FLinkerLoad::FindNewPathNameForClass("/Script/Landscape." + Type.ToString(), false)
-		};
-		
-		for (FString RedirectedPath : Redirects) {
-			if (!RedirectedPath.IsEmpty() && !Class)
-				Class = FindObject<UClass>(nullptr, *RedirectedPath);
-		}
-
-		if (!Class) 
-			Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString().Replace(TEXT("MaterialExpressionPhysicalMaterialOutput"), TEXT("MaterialExpressionLandscapePhysicalMaterialOutput")));
-	}
-
-	// Show missing nodes in graph
-	if (!Class) {
-		TSharedPtr<FJsonObject>* ShareObject = new TSharedPtr<FJsonObject>(LocalizedObject);
-		MissingNodeClasses.Add(Type.ToString(), ShareObject->Get());
-
-		GLog->Log(*("JsonAsAsset: Missing Node " + Type.ToString() + " in Parent " + Parent->GetName()));
-		FNotificationInfo Info = FNotificationInfo(FText::FromString("Missing Node (" + Parent->GetName() + ")"));
+		FImportDiagnostics::Get().Warning(EImportDiagnosticCategory::MissingClass, "Missing Node " + Type.ToString(), Parent->GetName());
 
-		Info.bUseLargeFont = false;
-		Info.bFireAndForget = false;
-		Info.FadeOutDuration = .5f;
-		Info.ExpireDuration = 8.0f;
-		Info.WidthOverride = FOptionalSize(456);
-		Info.bUseThrobber = false;
-		Info.SubText = FText::FromString(Type.ToString());
-
-#pragma warning(disable: 4800)
-		Info.Image = FSlateIconFinder::FindCustomIconBrushForClass(FindObject<UClass>(nullptr, "/Script/Engine.Material"), TEXT("ClassThumbnail"));
+		// Lean imports leave them out, instead of adding a placeholder reroute and comment
+		if (GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings.bLeanMaterialImport) {
+			return nullptr;
+		}
 
-		MaterialGraphNotification = FSlateNotificationManager::Get().AddNotification(Info);
-		MaterialGraphNotification.Pin()->SetCompletionState(SNotificationItem::CS_Pending);
+		MissingNodeClasses.Add(Type.ToString(), LocalizedObject);
 
 		return NewObject<UMaterialExpression>(
 			Parent,
@@ -306,7 +981,7 @@ UMaterialExpression* IMaterialGraph::CreateEmptyExpression(UObject* Parent, FNam
 	return NewObject<UMaterialExpression>
 	(
 		Parent,
-		Class, // Find class using ANY_PACKAGE (may error in the future)
+		Class,
 		Name,
 		RF_Transactional
 	);
@@ -11,6 +11,7 @@
 #include "Sound/SoundCue.h"
 #include "ToolMenus.h"
 #include "Settings/JsonAsAssetSettings.h"
+#include "Utilities/ImportSession.h"
 
 bool ISoundGraph::ImportData() {
 	try {
@@ -65,7 +66,7 @@ void ISoundGraph::ConstructNodes(USoundCue* SoundCue, TArray<TSharedPtr<FJsonVal
 }
 
 USoundNode* ISoundGraph::CreateEmptyNode(FName Name, FName Type, USoundCue* SoundCue) {
-	UClass* Class = FindObject<UClass>(ANY_PACKAGE, *Type.ToString());
+	UClass* Class = FImportSession::Get().FindClass(Type.ToString());
 
 	// TODO: Construct the sound node manually to have the exact same object name
 	return SoundCue->ConstructSoundNode<USoundNode>(
@@ -13,8 +13,6 @@ bool TemplatedImporter<AssetType>::ImportData() {
 		TSharedPtr<FJsonObject> Properties = JsonObject->GetObjectField("Properties");
 		GetObjectSerializer()->SetPackageForDeserialization(Package);
 
-		AssetType* Asset = NewObject<AssetType>(Package, AssetClass ? AssetClass : AssetType::StaticClass(), FName(FileName), RF_Public | RF_Standalone);
-
 		// Property MASH
 		for (FString& PropertyName : PropertyMash) {
 			if (JsonObject->HasField(PropertyName)) {
@@ -25,6 +23,10 @@ bool TemplatedImporter<AssetType>::ImportData() {
 			}
 		}
 
+		if (PatchExistingAsset(AssetClass ? AssetClass : AssetType::StaticClass(), Properties)) return true;
+
+		AssetType* Asset = NewObject<AssetType>(Package, AssetClass ? AssetClass : AssetType::StaticClass(), FName(FileName), RF_Public | RF_Standalone);
+
 		GetObjectSerializer()->DeserializeObjectProperties(Properties, Asset);
 
 		return OnAssetCreation(Asset);
@@ -2,6 +2,7 @@
 
 #include "Importers/Types/BlendSpaceImporter.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/PropertyBinder.h"
 
 void UBlendSpaceDerived::AddSampleOnly(UAnimSequence* AnimationSequence, const FVector& SampleValue) {
 	SampleData.Add(FBlendSample(AnimationSequence, SampleValue, true, true));
@@ -31,6 +32,15 @@ void UBlendSpaceDerived::SetNotifyTriggerMode(const ENotifyTriggerMode::Type Not
 	this->NotifyTriggerMode = NotifyTriggerModeInput;
 }
 
+static const TPropertyBinder<FBlendParameter> BlendParameterBinder = TPropertyBinder<FBlendParameter>()
+	.Bind(TEXT("DisplayName"), &FBlendParameter::DisplayName)
+	.Bind(TEXT("Min"), &FBlendParameter::Min)
+	.Bind(TEXT("Max"), &FBlendParameter::Max)
+	.Bind(TEXT("GridNum"), &FBlendParameter::GridNum);
+
+static const TPropertyBinder<FInterpolationParameter> InterpolationParameterBinder = TPropertyBinder<FInterpolationParameter>()
+	.Bind(TEXT("InterpolationTime"), &FInterpolationParameter::InterpolationTime);
+
 bool UBlendSpaceImporter::ImportData() {
 	try {
 		TSharedPtr<FJsonObject> AssetData = JsonObject->GetObjectField("Properties");
@@ -44,14 +54,8 @@ bool UBlendSpaceImporter::ImportData() {
 			const TSharedPtr<FJsonObject> BlendParamsObject = AssetData->GetObjectField("BlendParameters");
 
 			FBlendParameter PrimaryBlendParam;
-			PrimaryBlendParam.DisplayName = BlendParamsObject->GetStringField("DisplayName");
-			PrimaryBlendParam.Min = BlendParamsObject->GetNumberField("Min");
-			PrimaryBlendParam.Max = BlendParamsObject->GetNumberField("Max");
-			if (BlendParamsObject->HasField("GridNum")) {
-				PrimaryBlendParam.GridNum = BlendParamsObject->GetNumberField("GridNum");
-			} else {
-				PrimaryBlendParam.GridNum = 4;
-			}
+			PrimaryBlendParam.GridNum = 4;
+			BlendParameterBinder.Apply(BlendParamsObject, PrimaryBlendParam);
 
 			Cast<UBlendSpaceDerived>(BlendSpace)->SetBlendParameterPrimary(PrimaryBlendParam);
 		}
@@ -61,15 +65,8 @@ bool UBlendSpaceImporter::ImportData() {
 			const TSharedPtr<FJsonObject> BlendParamsObjectSecondary = AssetData->GetObjectField("BlendParameters[1]");
 
 			FBlendParameter SecondaryBlendParam;
-			SecondaryBlendParam.DisplayName = BlendParamsObjectSecondary->GetStringField("DisplayName");
-			SecondaryBlendParam.Min = BlendParamsObjectSecondary->GetNumberField("Min");
-			SecondaryBlendParam.Max = BlendParamsObjectSecondary->GetNumberField("Max");
-
-			if (BlendParamsObjectSecondary->HasField("GridNum")) {
-				SecondaryBlendParam.GridNum = BlendParamsObjectSecondary->GetNumberField("GridNum");
-			} else {
-				SecondaryBlendParam.GridNum = 4;
-			}
+			SecondaryBlendParam.GridNum = 4;
+			BlendParameterBinder.Apply(BlendParamsObjectSecondary, SecondaryBlendParam);
 
 			Cast<UBlendSpaceDerived>(BlendSpace)->SetBlendParameterSecondary(SecondaryBlendParam);
 		}
@@ -78,7 +75,7 @@ bool UBlendSpaceImporter::ImportData() {
 			const TSharedPtr<FJsonObject> InterpolationParamObject = AssetData->GetObjectField("InterpolationParam");
 
 			FInterpolationParameter PrimaryInterpolationParam;
-			PrimaryInterpolationParam.InterpolationTime = InterpolationParamObject->GetNumberField("InterpolationTime");
+			InterpolationParameterBinder.Apply(InterpolationParamObject, PrimaryInterpolationParam);
 
 			Cast<UBlendSpaceDerived>(BlendSpace)->SetInterpolationParamPrimary(PrimaryInterpolationParam);
 		}
@@ -87,7 +84,7 @@ bool UBlendSpaceImporter::ImportData() {
 			const TSharedPtr<FJsonObject> InterpolationParamObjectSecondary = AssetData->GetObjectField("InterpolationParam[1]");
 
 			FInterpolationParameter SecondaryInterpolationParam;
-			SecondaryInterpolationParam.InterpolationTime = InterpolationParamObjectSecondary->GetNumberField("InterpolationTime");
+			InterpolationParameterBinder.Apply(InterpolationParamObjectSecondary, SecondaryInterpolationParam);
 
 			Cast<UBlendSpaceDerived>(BlendSpace)->SetInterpolationParamSecondary(SecondaryInterpolationParam);
 		}
@@ -8,6 +8,8 @@ bool UDataAssetImporter::ImportData() {
 		TSharedPtr<FJsonObject> Properties = JsonObject->GetObjectField("Properties");
 		GetObjectSerializer()->SetPackageForDeserialization(Package);
 
+		if (PatchExistingAsset(DataAssetClass, Properties)) return true;
+
 		UDataAsset* DataAsset = NewObject<UDataAsset>(Package, DataAssetClass, FName(FileName), RF_Public | RF_Standalone);
 		GetObjectSerializer()->DeserializeObjectProperties(Properties, DataAsset);
 
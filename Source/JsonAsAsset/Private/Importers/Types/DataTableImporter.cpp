@@ -2,6 +2,7 @@
 
 #include "Importers/Types/DataTableImporter.h"
 #include "Dom/JsonObject.h"
+#include "Utilities/ImportDiagnostics.h"
 
 // Shout-out to UEAssetToolkit
 bool UDataTableImporter::ImportData() {
@@ -22,7 +23,7 @@ bool UDataTableImporter::ImportData() {
 		// Find Table Row Struct
 		UScriptStruct* TableRowStruct = FindObject<UScriptStruct>(ANY_PACKAGE, *TableStruct); {
 			if (TableRowStruct == NULL) {
-				AppendNotification(FText::FromString("DataTable Missing: " + TableStruct), FText::FromString(FileName), 2.0f, SNotificationItem::CS_Fail, true, 350.0f);
+				FImportDiagnostics::Get().Error(EImportDiagnosticCategory::MissingReference, "DataTable Row Struct Missing: " + TableStruct, FileName);
 
 				return false;
 			} else DataTable->RowStruct = TableRowStruct;
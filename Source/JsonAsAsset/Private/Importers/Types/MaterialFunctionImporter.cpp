@@ -2,9 +2,35 @@
 
 #include "Importers/Types/MaterialFunctionImporter.h"
 #include "Factories/MaterialFunctionFactoryNew.h"
+#include "Utilities/ImportDiagnostics.h"
+#include "Utilities/ImportSession.h"
+#include "Settings/JsonAsAssetSettings.h"
 
 bool UMaterialFunctionImporter::ImportData() {
 	try {
+		// Define editor only data from the JSON
+		TMap<FName, FExportData> Exports;
+		TArray<FName> ExpressionNames;
+		const TSharedPtr<FJsonObject> EditorOnlyData = FindEditorOnlyData(JsonObject->GetStringField("Type"), FileName, Exports, ExpressionNames, false);
+
+		// Missing Material Data
+		if (!EditorOnlyData.IsValid() || Exports.IsEmpty()) {
+			FImportDiagnostics::Get().Error(EImportDiagnosticCategory::MissingData, "Material Data Missing, please use the correct FModel provided in the JsonAsAsset server", FileName);
+
+			return false;
+		}
+
+		// Parse and check the graph before anything is created
+		FMaterialGraphIR Graph = BuildGraphIR(FileName, ExpressionNames, Exports);
+		if (!ValidateGraphIR(Graph)) return false;
+
+		// Copies of a graph imported earlier in this run aren't built again
+		FString GraphHash;
+		if (HandleDuplicateGraph(GraphHash)) return true;
+
+		const FMaterialImportSettings& MaterialSettings = GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings;
+		if (MaterialSettings.bLeanMaterialImport) PrepareLeanImport(Graph, Exports);
+
 		// Create Material Function Factory (factory automatically creates the MF)
 		UMaterialFunctionFactoryNew* MaterialFunctionFactory = NewObject<UMaterialFunctionFactoryNew>();
 		UMaterialFunction* MaterialFunction = Cast<UMaterialFunction>(MaterialFunctionFactory->FactoryCreateNew(UMaterialFunction::StaticClass(), OutermostPkg, *FileName, RF_Standalone | RF_Public, nullptr, GWarn));
@@ -20,37 +46,35 @@ bool UMaterialFunctionImporter::ImportData() {
 		if (bool bExposeToLibrary; JsonObject->GetObjectField("Properties")->TryGetBoolField("bExposeToLibrary", bExposeToLibrary)) MaterialFunction->bExposeToLibrary = bExposeToLibrary;
 		if (bool bPrefixParameterNames; JsonObject->GetObjectField("Properties")->TryGetBoolField("bPrefixParameterNames", bPrefixParameterNames)) MaterialFunction->bPrefixParameterNames = bPrefixParameterNames;
 
-		// Define editor only data from the JSON
-		TMap<FName, FExportData> Exports;
-		TArray<FName> ExpressionNames;
-		const TSharedPtr<FJsonObject> EdProps = FindEditorOnlyData(JsonObject->GetStringField("Type"), MaterialFunction->GetName(), Exports, ExpressionNames, false)->GetObjectField("Properties");
+		const TSharedPtr<FJsonObject> EdProps = EditorOnlyData->GetObjectField("Properties");
 		const TSharedPtr<FJsonObject> StringExpressionCollection = EdProps->GetObjectField("ExpressionCollection");
 
+		// Import the functions this graph calls before building it
+		PrefetchMaterialFunctions(Exports);
+
 		// Map out each expression for easier access
-		TMap<FName, UMaterialExpression*> CreatedExpressionMap = ConstructExpressions(MaterialFunction, MaterialFunction->GetName(), ExpressionNames, Exports);
+		TMap<FName, UMaterialExpression*> CreatedExpressionMap = ConstructExpressions(MaterialFunction, Graph);
 
-		// Missing Material Data
-		if (Exports.IsEmpty()) {
-			FNotificationInfo Info = FNotificationInfo(FText::FromString("Material Data Missing (" + FileName + ")"));
-			Info.ExpireDuration = 7.0f;
-			Info.bUseLargeFont = true;
-			Info.bUseSuccessFailIcons = true;
-			Info.WidthOverride = FOptionalSize(350);
-			Info.SubText = FText::FromString(FString("Please use the correct FModel provided in the JsonAsAsset server."));
+		// Pins between expressions of this graph are linked by name
+		FScopedExpressionInputLinking ExpressionInputLinking(GetObjectSerializer()->GetPropertySerializer(), CreatedExpressionMap, Graph.BypassedReroutes);
 
-			TSharedPtr<SNotificationItem> NotificationPtr = FSlateNotificationManager::Get().AddNotification(Info);
-			NotificationPtr->SetCompletionState(SNotificationItem::CS_Fail);
+		// Iterate through all the expression names
+		PropagateExpressions(MaterialFunction, ExpressionNames, Exports, CreatedExpressionMap);
 
-			return false;
+		// Comments are only there for whoever opens the graph
+		if (!MaterialSettings.bLeanMaterialImport) {
+			MaterialGraphNode_ConstructComments(MaterialFunction, StringExpressionCollection, Exports);
 		}
 
-		// Iterate through all the expression names
-		PropagateExpressions(MaterialFunction, ExpressionNames, Exports, CreatedExpressionMap);
-		MaterialGraphNode_ConstructComments(MaterialFunction, StringExpressionCollection, Exports);
+		if (MaterialSettings.bCollapseMaterialSwitches) {
+			CollapseMaterialSwitches(MaterialFunction);
+		}
 
 		MaterialFunction->PreEditChange(NULL);
 		MaterialFunction->PostEditChange();
 
+		if (!GraphHash.IsEmpty()) FImportSession::Get().AddCanonicalGraph(GraphHash, MaterialFunction);
+
 		SavePackage();
 	} catch (const char* Exception) {
 		UE_LOG(LogJson, Error, TEXT("%s"), *FString(Exception))
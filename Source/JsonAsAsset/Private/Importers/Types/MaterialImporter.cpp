@@ -14,17 +14,15 @@
 
 #include "Factories/MaterialFactoryNew.h"
 #include "MaterialGraph/MaterialGraph.h"
-#include <Editor/UnrealEd/Classes/MaterialGraph/MaterialGraphNode_Composite.h>
 #include <Editor/UnrealEd/Classes/MaterialGraph/MaterialGraphSchema.h>
 
-#include "Editor/MaterialEditor/Private/MaterialEditor.h"
 #include "Settings/JsonAsAssetSettings.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ImportDiagnostics.h"
 
 void UMaterialImporter::ComposeExpressionPinBase(UMaterialExpressionPinBase* Pin, TMap<FName, UMaterialExpression*>& CreatedExpressionMap, const TSharedPtr<FJsonObject>& _JsonObject, TMap<FName, FExportData>& Exports) {
 	FJsonObject* Expression = (Exports.Find(GetExportNameOfSubobject(_JsonObject->GetStringField("ObjectName")))->Json)->GetObjectField("Properties").Get();
 
-	Pin->GraphNode->NodePosX = Expression->GetNumberField("MaterialExpressionEditorX");
-	Pin->GraphNode->NodePosY = Expression->GetNumberField("MaterialExpressionEditorY");
 	Pin->MaterialExpressionEditorX = Expression->GetNumberField("MaterialExpressionEditorX");
 	Pin->MaterialExpressionEditorY = Expression->GetNumberField("MaterialExpressionEditorY");
 
@@ -71,6 +69,29 @@ void UMaterialImporter::ComposeExpressionPinBase(UMaterialExpressionPinBase* Pin
 
 bool UMaterialImporter::ImportData() {
 	try {
+		// Define editor only data from the JSON
+		TMap<FName, FExportData> Exports;
+		TArray<FName> ExpressionNames;
+		const TSharedPtr<FJsonObject> EditorOnlyData = FindEditorOnlyData(JsonObject->GetStringField("Type"), FileName, Exports, ExpressionNames, false);
+
+		// Missing Material Data
+		if (!EditorOnlyData.IsValid() || Exports.IsEmpty()) {
+			FImportDiagnostics::Get().Error(EImportDiagnosticCategory::MissingData, "Material Data Missing, please use the correct FModel provided in the JsonAsAsset server", FileName);
+
+			return false;
+		}
+
+		// Parse and check the graph before anything is created
+		FMaterialGraphIR Graph = BuildGraphIR(FileName, ExpressionNames, Exports);
+		if (!ValidateGraphIR(Graph)) return false;
+
+		// Copies of a graph imported earlier in this run aren't built again
+		FString GraphHash;
+		if (HandleDuplicateGraph(GraphHash)) return true;
+
+		const FMaterialImportSettings& MaterialSettings = GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings;
+		if (MaterialSettings.bLeanMaterialImport) PrepareLeanImport(Graph, Exports);
+
 		// Create Material Factory (factory automatically creates the Material)
 		UMaterialFactoryNew* MaterialFactory = NewObject<UMaterialFactoryNew>();
 		UMaterial* Material = Cast<UMaterial>(MaterialFactory->FactoryCreateNew(UMaterial::StaticClass(), OutermostPkg, *FileName, RF_Standalone | RF_Public, nullptr, GWarn));
@@ -82,34 +103,26 @@ bool UMaterialImporter::ImportData() {
 		// Clear any default expressions the engine adds
 		Material->GetExpressionCollection().Empty();
 
-		// Define editor only data from the JSON
-		TMap<FName, FExportData> Exports;
-		TArray<FName> ExpressionNames;
-		TSharedPtr<FJsonObject> EdProps = FindEditorOnlyData(JsonObject->GetStringField("Type"), Material->GetName(), Exports, ExpressionNames, false)->GetObjectField("Properties");
+		TSharedPtr<FJsonObject> EdProps = EditorOnlyData->GetObjectField("Properties");
 		const TSharedPtr<FJsonObject> StringExpressionCollection = EdProps->GetObjectField("ExpressionCollection");
 
-		// Map out each expression for easier access
-		TMap<FName, UMaterialExpression*> CreatedExpressionMap = ConstructExpressions(Material, Material->GetName(), ExpressionNames, Exports);
-		const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
+		// Import the functions this graph calls before building it
+		PrefetchMaterialFunctions(Exports);
 
-		// Missing Material Data
-		if (Exports.IsEmpty()) {
-			FNotificationInfo Info = FNotificationInfo(FText::FromString("Material Data Missing (" + FileName + ")"));
-			Info.ExpireDuration = 7.0f;
-			Info.bUseLargeFont = true;
-			Info.bUseSuccessFailIcons = true;
-			Info.WidthOverride = FOptionalSize(350);
-			Info.SubText = FText::FromString(FString("Please use the correct FModel provided in the JsonAsAsset server."));
-
-			TSharedPtr<SNotificationItem> NotificationPtr = FSlateNotificationManager::Get().AddNotification(Info);
-			NotificationPtr->SetCompletionState(SNotificationItem::CS_Fail);
+		// Map out each expression for easier access
+		TMap<FName, UMaterialExpression*> CreatedExpressionMap = ConstructExpressions(Material, Graph);
 
-			return false;
-		}
+		// Pins between expressions of this graph are linked by name
+		FScopedExpressionInputLinking ExpressionInputLinking(GetObjectSerializer()->GetPropertySerializer(), CreatedExpressionMap, Graph.BypassedReroutes);
+		const UJsonAsAssetSettings* Settings = GetDefault<UJsonAsAssetSettings>();
 
 		// Iterate through all the expression names
 		PropagateExpressions(Material, ExpressionNames, Exports, CreatedExpressionMap, true);
-		MaterialGraphNode_ConstructComments(Material, StringExpressionCollection, Exports);
+
+		// Comments are only there for whoever opens the graph
+		if (!MaterialSettings.bLeanMaterialImport) {
+			MaterialGraphNode_ConstructComments(Material, StringExpressionCollection, Exports);
+		}
 
 		if (!Settings->AssetSettings.MaterialImportSettings.bSkipResultNodeConnection) {
 			TArray<FString> IgnoredProperties = TArray<FString> {
@@ -134,6 +147,12 @@ bool UMaterialImporter::ImportData() {
 					FJsonObject* InputObject = InputValue->AsObject().Get();
 					FName InputExpressionName = GetExpressionName(InputObject);
 
+					// Connected through a reroute left out of the graph
+					if (const TSharedPtr<FJsonObject>* Source = Graph.BypassedReroutes.Find(InputExpressionName); Source && Source->IsValid()) {
+						InputObject = Source->Get();
+						InputExpressionName = GetExpressionName(InputObject);
+					}
+
 					if (CreatedExpressionMap.Contains(InputExpressionName)) {
 						FExpressionInput Input = PopulateExpressionInput(InputObject, *CreatedExpressionMap.Find(InputExpressionName));
 						Material->GetEditorOnlyData()->CustomizedUVs[i] = *reinterpret_cast<FVector2MaterialInput*>(&Input);
@@ -165,10 +184,7 @@ bool UMaterialImporter::ImportData() {
 		// Handle edit changes, and add it to the content browser
 		if (!HandleAssetCreation(Material)) return false;
 
-		bool bEditorGraphOpen = false;
-		FMaterialEditor* AssetEditorInstance = nullptr;
-
-		// Handle Material Graphs
+		// Handle Material Graphs (composites are built from expressions alone, the editor builds its graph once opened)
 		for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
 			TSharedPtr<FJsonObject> Object = TSharedPtr(Value->AsObject());
 
@@ -176,179 +192,117 @@ bool UMaterialImporter::ImportData() {
 			FString Name = Object->GetStringField("Name");
 
 			if (ExType == "MaterialGraph" && Name != "MaterialGraph_0") {
-				TSharedPtr<FJsonObject> GraphProperties = Object->GetObjectField("Properties");
-				TSharedPtr<FJsonObject> SubgraphExpression;
-
-				FString SubgraphExpressionName;
-
-				if (!bEditorGraphOpen) {
-					// Create Editor
-					UAssetEditorSubsystem* AssetEditorSubsystem = GEditor->GetEditorSubsystem<UAssetEditorSubsystem>();
-					AssetEditorInstance = reinterpret_cast<FMaterialEditor*>(AssetEditorSubsystem->OpenEditorForAsset(Material) ? AssetEditorSubsystem->FindEditorForAsset(Material, true) : nullptr);
-
-					bEditorGraphOpen = true;
-				}
-
-				// Set SubgraphExpression
 				const TSharedPtr<FJsonObject>* SubgraphExpressionPtr = nullptr;
-				if (GraphProperties->TryGetObjectField("SubgraphExpression", SubgraphExpressionPtr) && SubgraphExpressionPtr != nullptr) {
-					FJsonObject* SubgraphExpressionObject = SubgraphExpressionPtr->Get();
-					FName ExportName = GetExportNameOfSubobject(SubgraphExpressionObject->GetStringField("ObjectName"));
+				if (!Object->GetObjectField("Properties")->TryGetObjectField("SubgraphExpression", SubgraphExpressionPtr) || SubgraphExpressionPtr == nullptr) continue;
 
-					SubgraphExpressionName = ExportName.ToString();
-					FExportData Export = *Exports.Find(ExportName);
-					SubgraphExpression = Export.Json->GetObjectField("Properties");
-				}
-
-				// Find Material Graph
-				UMaterialGraph* MaterialGraph = AssetEditorInstance->Material->MaterialGraph;
-				if (MaterialGraph == nullptr) {
-					UE_LOG(LogJson, Log, TEXT("The material graph is not valid!"));
-				}
-
-				MaterialGraph->Modify();
-
-				// Create the composite node that will serve as the gateway into the subgraph
-				UMaterialGraphNode_Composite* GatewayNode = nullptr;
-				{
-					GatewayNode = Cast<UMaterialGraphNode_Composite>(FMaterialGraphSchemaAction_NewComposite::SpawnNode(MaterialGraph, FVector2D(SubgraphExpression->GetNumberField("MaterialExpressionEditorX"), SubgraphExpression->GetNumberField("MaterialExpressionEditorY"))));
-					GatewayNode->bCanRenameNode = true;
-					check(GatewayNode);
-				}
+				ConstructComposite(Material, Name, SubgraphExpressionPtr->Get(), CreatedExpressionMap, Exports);
+			}
+		}
 
-				UMaterialGraph* DestinationGraph = Cast<UMaterialGraph>(GatewayNode->BoundGraph);
-				UMaterialExpressionComposite* CompositeExpression = CastChecked<UMaterialExpressionComposite>(GatewayNode->MaterialExpression);
-				{
-					CompositeExpression->Material = Material;
-					CompositeExpression->SubgraphName = Name;
+		if (Settings->AssetSettings.MaterialImportSettings.bCollapseMaterialSwitches) {
+			CollapseMaterialSwitches(Material);
+		}
 
-					MaterialGraphNode_ExpressionWrapper(Material, CompositeExpression, SubgraphExpression);
-				}
+		if (const TSharedPtr<FJsonObject>* ShadingModelsPtr; Properties->TryGetObjectField("ShadingModels", ShadingModelsPtr))
+			if (int ShadingModelField; ShadingModelsPtr->Get()->TryGetNumberField("ShadingModelField", ShadingModelField))
+				Material->GetShadingModels().SetShadingModelField(ShadingModelField);
 
-				// Create notification
-				FNotificationInfo Info = FNotificationInfo(FText::FromString("Material Graph imported incomplete"));
-				Info.ExpireDuration = 2.0f;
-				Info.bUseLargeFont = true;
-				Info.bUseSuccessFailIcons = true;
-				Info.WidthOverride = FOptionalSize(350);
-				Info.SubText = FText::FromString(FString("Material"));
+		TSharedPtr<FJsonObject> SerializerProperties = TSharedPtr(Properties);
+		if (SerializerProperties->HasField("ShadingModel")) // ShadingModel set manually
+			SerializerProperties->RemoveField("ShadingModel");
 
-				// Set icon as successful
-				TSharedPtr<SNotificationItem> NotificationPtr = FSlateNotificationManager::Get().AddNotification(Info);
-				NotificationPtr->SetCompletionState(SNotificationItem::CS_Fail);
+		GetObjectSerializer()->DeserializeObjectProperties(SerializerProperties, Material);
 
-				DestinationGraph->Rename(*CompositeExpression->SubgraphName);
-				DestinationGraph->Material = MaterialGraph->Material;
+		if (FString ShadingModel; Properties->TryGetStringField("ShadingModel", ShadingModel) && ShadingModel != "EMaterialShadingModel::MSM_FromMaterialExpression")
+			Material->SetShadingModel(static_cast<EMaterialShadingModel>(StaticEnum<EMaterialShadingModel>()->GetValueByNameString(ShadingModel)));
 
-				// Add Sub-Graph Nodes
-				{
-					TArray<TSharedPtr<FJsonValue>> MaterialGraphNodes = FilterGraphNodesBySubgraphExpression(SubgraphExpressionName);
-					TMap<FName, FExportData> SubGraphExports;
-					TMap<FName, UMaterialExpression*> SubgraphExpressionMapping;
-					TArray<FName> SubGraphExpressionNames;
+		if (FImportSession::Get().IsDeferringMaterialUpdates()) {
+			FImportSession::Get().DeferMaterialUpdate(Material);
+		} else {
+			Material->ForceRecompileForRendering();
 
-					// Go through each expression
-					for (const TSharedPtr<FJsonValue> _GraphNode : MaterialGraphNodes) {
-						const TSharedPtr<FJsonObject> MaterialGraphObject = TSharedPtr(_GraphNode->AsObject());
+			Material->PostEditChange();
+			Material->PreEditChange(nullptr);
+		}
 
-						FString GraphNode_Type = MaterialGraphObject->GetStringField("Type");
-						FString GraphNode_Name = MaterialGraphObject->GetStringField("Name");
+		Material->MarkPackageDirty();
 
-						FName GraphNodeNameName = FName(GraphNode_Name);
+		if (!GraphHash.IsEmpty()) FImportSession::Get().AddCanonicalGraph(GraphHash, Material);
 
-						TSharedPtr<FJsonObject>* SharedGraphObject = new TSharedPtr<FJsonObject>(MaterialGraphObject);
+		SavePackage();
+	} catch (const char* Exception) {
+		UE_LOG(LogJson, Error, TEXT("%s"), *FString(Exception));
+		return false;
+	}
 
-						UMaterialExpression* Ex = CreateEmptyExpression(MaterialGraph->Material, GraphNodeNameName, FName(GraphNode_Type), SharedGraphObject->Get());
-						if (Ex == nullptr)
-							continue;
+	return true;
+}
 
-						Ex->SubgraphExpression = CompositeExpression;
-						Ex->Material = MaterialGraph->Material;
+UMaterialExpressionComposite* UMaterialImporter::ConstructComposite(UMaterial* Material, const FString& GraphName, const FJsonObject* SubgraphExpressionObject, TMap<FName, UMaterialExpression*>& CreatedExpressionMap, TMap<FName, FExportData>& Exports) {
+	const FName CompositeName = GetExportNameOfSubobject(SubgraphExpressionObject->GetStringField("ObjectName"));
 
-						SubGraphExpressionNames.Add(GraphNodeNameName);
-						SubGraphExports.Add(GraphNodeNameName, FExportData(GraphNode_Type, MaterialGraph->Material->GetName(), MaterialGraphObject));
-						SubgraphExpressionMapping.Add(GraphNodeNameName, Ex);
-					}
+	const FExportData* CompositeExport = Exports.Find(CompositeName);
+	if (CompositeExport == nullptr) return nullptr;
 
-					// Setup Input/Output Expressions
-					{
-						const TSharedPtr<FJsonObject>* InputExpressions;
-						if (SubgraphExpression->TryGetObjectField("InputExpressions", InputExpressions)) {
-							TSharedPtr<FJsonObject> InputExpression = TSharedPtr<FJsonObject>(InputExpressions->Get());
+	const TSharedPtr<FJsonObject> SubgraphExpression = CompositeExport->Json->GetObjectField("Properties");
 
-							ComposeExpressionPinBase(CompositeExpression->InputExpressions, CreatedExpressionMap, InputExpression, Exports);
-						}
+	// Create the composite, and the pins that act as the subgraph's inputs and outputs
+	UMaterialExpressionComposite* CompositeExpression = NewObject<UMaterialExpressionComposite>(Material, CompositeName, RF_Transactional);
+	CompositeExpression->SubgraphName = GraphName;
 
-						const TSharedPtr<FJsonObject>* OutputExpressions;
-						if (SubgraphExpression->TryGetObjectField("OutputExpressions", OutputExpressions)) {
-							TSharedPtr<FJsonObject> OutputExpression = TSharedPtr<FJsonObject>(OutputExpressions->Get());
+	MaterialGraphNode_ExpressionWrapper(Material, CompositeExpression, SubgraphExpression);
 
-							ComposeExpressionPinBase(CompositeExpression->OutputExpressions, CreatedExpressionMap, OutputExpression, Exports);
-						}
-					}
+	auto CreatePinBase = [&](const FString& FieldName, const EEdGraphPinDirection Direction) -> UMaterialExpressionPinBase* {
+		const TSharedPtr<FJsonObject>* PinObject;
+		if (!SubgraphExpression->TryGetObjectField(FieldName, PinObject)) return nullptr;
 
-					// Add all the expression properties
-					PropagateExpressions(MaterialGraph->Material, SubGraphExpressionNames, Exports, SubgraphExpressionMapping, true);
+		const FName PinName = GetExportNameOfSubobject(PinObject->Get()->GetStringField("ObjectName"));
+		if (!Exports.Contains(PinName)) return nullptr;
 
-					// All expressions (hopefully) have their properties
-					// so now we just make a material graph node for each
-					for (const TPair<FName, UMaterialExpression*>& pair : SubgraphExpressionMapping) {
-						UMaterialExpression* Expression = pair.Value;
-						UMaterialGraphNode* NewNode = DestinationGraph->AddExpression(Expression, false);
+		UMaterialExpressionPinBase* Pin = NewObject<UMaterialExpressionPinBase>(Material, PinName, RF_Transactional);
+		Pin->Material = Material;
+		Pin->SubgraphExpression = CompositeExpression;
+		Pin->PinDirection = Direction;
 
-						const FGuid NewGuid = FGuid::NewGuid();
-						NewNode->NodeGuid = NewGuid;
+		ComposeExpressionPinBase(Pin, CreatedExpressionMap, *PinObject, Exports);
 
-						NewNode->NodePosX = Expression->MaterialExpressionEditorX;
-						NewNode->NodePosY = Expression->MaterialExpressionEditorY;
-						NewNode->MaterialExpression = Expression;
+		return Pin;
+	};
 
-						DestinationGraph->AddNode(NewNode);
-						NewNode->ReconstructNode();
-					}
-				}
+	// Gather the expressions living inside the subgraph, reusing any already constructed
+	TArray<FName> SubgraphExpressionNames;
 
-				CompositeExpression->InputExpressions->Material = MaterialGraph->Material;
-				CompositeExpression->OutputExpressions->Material = MaterialGraph->Material;
+	for (const TSharedPtr<FJsonValue> GraphNode : FilterGraphNodesBySubgraphExpression(CompositeName.ToString())) {
+		const TSharedPtr<FJsonObject> GraphNodeObject = GraphNode->AsObject();
+		const FName GraphNodeName(GraphNodeObject->GetStringField("Name"));
 
-				GatewayNode->ReconstructNode();
-				Cast<UMaterialGraphNode>(CompositeExpression->InputExpressions->GraphNode)->ReconstructNode();
-				Cast<UMaterialGraphNode>(CompositeExpression->OutputExpressions->GraphNode)->ReconstructNode();
+		UMaterialExpression* Expression = CreatedExpressionMap.FindRef(GraphNodeName);
 
-				DestinationGraph->RebuildGraph();
-				DestinationGraph->LinkMaterialExpressionsFromGraph();
+		if (Expression == nullptr) {
+			Expression = CreateEmptyExpression(Material, GraphNodeName, FName(GraphNodeObject->GetStringField("Type")), GraphNodeObject.Get());
+			if (Expression == nullptr) continue;
 
-				// Update Original Material
-				AssetEditorInstance->UpdateMaterialAfterGraphChange();
-			}
+			CreatedExpressionMap.Add(GraphNodeName, Expression);
+			SubgraphExpressionNames.Add(GraphNodeName);
 		}
 
-		if (const TSharedPtr<FJsonObject>* ShadingModelsPtr; Properties->TryGetObjectField("ShadingModels", ShadingModelsPtr))
-			if (int ShadingModelField; ShadingModelsPtr->Get()->TryGetNumberField("ShadingModelField", ShadingModelField))
-				Material->GetShadingModels().SetShadingModelField(ShadingModelField);
-
-		TSharedPtr<FJsonObject> SerializerProperties = TSharedPtr(Properties);
-		if (SerializerProperties->HasField("ShadingModel")) // ShadingModel set manually
-			SerializerProperties->RemoveField("ShadingModel");
-
-		GetObjectSerializer()->DeserializeObjectProperties(SerializerProperties, Material);
+		Expression->SubgraphExpression = CompositeExpression;
+	}
 
-		if (FString ShadingModel; Properties->TryGetStringField("ShadingModel", ShadingModel) && ShadingModel != "EMaterialShadingModel::MSM_FromMaterialExpression")
-			Material->SetShadingModel(static_cast<EMaterialShadingModel>(StaticEnum<EMaterialShadingModel>()->GetValueByNameString(ShadingModel)));
+	// Pins reference reroutes inside the subgraph, so they are composed afterwards
+	CompositeExpression->InputExpressions = CreatePinBase("InputExpressions", EGPD_Output);
+	CompositeExpression->OutputExpressions = CreatePinBase("OutputExpressions", EGPD_Input);
 
-		Material->ForceRecompileForRendering();
+	// Add all the expression properties
+	PropagateExpressions(Material, SubgraphExpressionNames, Exports, CreatedExpressionMap, true);
 
-		Material->PostEditChange();
-		Material->MarkPackageDirty();
-		Material->PreEditChange(nullptr);
+	UMaterialEditorOnlyData* EditorOnlyData = Material->GetEditorOnlyData();
+	EditorOnlyData->ExpressionCollection.Expressions.Add(CompositeExpression);
 
-		SavePackage();
-	} catch (const char* Exception) {
-		UE_LOG(LogJson, Error, TEXT("%s"), *FString(Exception));
-		return false;
-	}
+	if (CompositeExpression->InputExpressions) EditorOnlyData->ExpressionCollection.Expressions.Add(CompositeExpression->InputExpressions);
+	if (CompositeExpression->OutputExpressions) EditorOnlyData->ExpressionCollection.Expressions.Add(CompositeExpression->OutputExpressions);
 
-	return true;
+	return CompositeExpression;
 }
 
 // Filter out Material Graph Nodes
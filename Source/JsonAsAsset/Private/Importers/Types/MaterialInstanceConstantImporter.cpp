@@ -5,18 +5,159 @@
 #include "Dom/JsonObject.h"
 #include "Materials/MaterialInstanceConstant.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/PropertyBinder.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ImportDiagnostics.h"
+#include "Utilities/AssetUtilities.h"
+#include "MaterialTypes.h"
 #include "RHIDefinitions.h"
 #include "MaterialShared.h"
 
+// Parameter values were always imported as global parameters, their association isn't read
+static const TPropertyBinder<FMaterialParameterInfo> ParameterInfoBinder = TPropertyBinder<FMaterialParameterInfo>()
+	.Bind(TEXT("Name"), &FMaterialParameterInfo::Name)
+	.Bind(TEXT("Index"), &FMaterialParameterInfo::Index);
+
+static const TPropertyBinder<FMaterialParameterInfo> StaticParameterInfoBinder = TPropertyBinder<FMaterialParameterInfo>()
+	.Bind(TEXT("Name"), &FMaterialParameterInfo::Name)
+	.Bind(TEXT("Association"), &FMaterialParameterInfo::Association)
+	.Bind(TEXT("Index"), &FMaterialParameterInfo::Index);
+
+// Shared by every parameter type, older versions only have a ParameterName
+template <typename TParameter>
+static TPropertyBinder<TParameter> MakeParameterBinder(const TPropertyBinder<FMaterialParameterInfo>& InfoBinder = ParameterInfoBinder) {
+	return TPropertyBinder<TParameter>()
+		.Bind(TEXT("ExpressionGUID"), &TParameter::ExpressionGUID)
+		.Bind(TEXT("ParameterInfo"), [&InfoBinder](TParameter& Parameter, const FJsonValue& Value) {
+			InfoBinder.Apply(Value.AsObject(), Parameter.ParameterInfo);
+		})
+		.Bind(TEXT("ParameterName"), [](TParameter& Parameter, const FJsonValue& Value) {
+			if (Parameter.ParameterInfo.Name.IsNone()) JsonBinding::ReadValue(Value, Parameter.ParameterInfo.Name);
+		});
+}
+
+static const TPropertyBinder<FScalarParameterValue> ScalarParameterBinder = MakeParameterBinder<FScalarParameterValue>()
+	.Bind(TEXT("ParameterValue"), &FScalarParameterValue::ParameterValue);
+
+static const TPropertyBinder<FVectorParameterValue> VectorParameterBinder = MakeParameterBinder<FVectorParameterValue>()
+	.Bind(TEXT("ParameterValue"), &FVectorParameterValue::ParameterValue);
+
+// Texture values are loaded by the importer itself
+static const TPropertyBinder<FTextureParameterValue> TextureParameterBinder = MakeParameterBinder<FTextureParameterValue>();
+
+static const TPropertyBinder<FStaticSwitchParameter> StaticSwitchParameterBinder = MakeParameterBinder<FStaticSwitchParameter>(StaticParameterInfoBinder)
+	.Bind(TEXT("Value"), &FStaticSwitchParameter::Value)
+	.Bind(TEXT("bOverride"), &FStaticSwitchParameter::bOverride);
+
+static const TPropertyBinder<FStaticComponentMaskParameter> StaticComponentMaskParameterBinder = MakeParameterBinder<FStaticComponentMaskParameter>(StaticParameterInfoBinder)
+	.Bind(TEXT("R"), &FStaticComponentMaskParameter::R)
+	.Bind(TEXT("G"), &FStaticComponentMaskParameter::G)
+	.Bind(TEXT("B"), &FStaticComponentMaskParameter::B)
+	.Bind(TEXT("A"), &FStaticComponentMaskParameter::A)
+	.Bind(TEXT("bOverride"), &FStaticComponentMaskParameter::bOverride);
+
+/*
+ * Parameters of an instance, read from the JSON and checked before the instance
+ * is created. Only texture references are left for the game thread to load.
+ */
+struct FMaterialInstanceIR {
+	TArray<FScalarParameterValue> ScalarParameterValues;
+	TArray<FVectorParameterValue> VectorParameterValues;
+	TArray<FTextureParameterValue> TextureParameterValues;
+
+	// Same order as TextureParameterValues, null if a parameter has no texture
+	TArray<TSharedPtr<FJsonObject>> TextureReferences;
+
+	TArray<FStaticSwitchParameter> StaticSwitchParameters;
+	TArray<FStaticComponentMaskParameter> StaticComponentMaskParameters;
+
+	TArray<FString> Errors;
+};
+
+template <typename TParameter>
+static void CheckParameterNames(const TArray<TParameter>& Parameters, const TCHAR* Type, TArray<FString>& OutErrors) {
+	for (const TParameter& Parameter : Parameters) {
+		if (Parameter.ParameterInfo.Name.IsNone()) OutErrors.Add(FString::Printf(TEXT("%s parameter without a name"), Type));
+	}
+}
+
+static const TArray<TSharedPtr<FJsonValue>>& GetArrayOrEmpty(const TSharedPtr<FJsonObject>& Object, const TCHAR* Field) {
+	static const TArray<TSharedPtr<FJsonValue>> Empty;
+
+	const TArray<TSharedPtr<FJsonValue>>* Array;
+	return Object->TryGetArrayField(Field, Array) ? *Array : Empty;
+}
+
+static FMaterialInstanceIR BuildParameterIR(const TSharedPtr<FJsonObject>& Properties, const TArray<TSharedPtr<FJsonObject>>& EditorOnlyData) {
+	FMaterialInstanceIR Instance;
+
+	for (const TSharedPtr<FJsonValue>& Scalar : GetArrayOrEmpty(Properties, TEXT("ScalarParameterValues"))) {
+		ScalarParameterBinder.Apply(Scalar->AsObject(), Instance.ScalarParameterValues.AddDefaulted_GetRef());
+	}
+
+	for (const TSharedPtr<FJsonValue>& Vector : GetArrayOrEmpty(Properties, TEXT("VectorParameterValues"))) {
+		VectorParameterBinder.Apply(Vector->AsObject(), Instance.VectorParameterValues.AddDefaulted_GetRef());
+	}
+
+	for (const TSharedPtr<FJsonValue>& TextureValue : GetArrayOrEmpty(Properties, TEXT("TextureParameterValues"))) {
+		const TSharedPtr<FJsonObject> Texture = TextureValue->AsObject();
+		TextureParameterBinder.Apply(Texture, Instance.TextureParameterValues.AddDefaulted_GetRef());
+
+		const TSharedPtr<FJsonObject>* TexturePtr = nullptr;
+		Instance.TextureReferences.Add(Texture->TryGetObjectField("ParameterValue", TexturePtr) && TexturePtr != nullptr ? *TexturePtr : nullptr);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> Local_StaticParameterObjects;
+	TArray<TSharedPtr<FJsonValue>> Local_StaticComponentMaskParametersObjects;
+	const TSharedPtr<FJsonObject>* StaticParams;
+
+	if (Properties->TryGetObjectField("StaticParametersRuntime", StaticParams)) {
+		Local_StaticParameterObjects = StaticParams->Get()->GetArrayField("StaticSwitchParameters");
+	} else if (EditorOnlyData.Num() > 0) {
+		for (TSharedPtr<FJsonObject> Ed : EditorOnlyData) {
+			const TSharedPtr<FJsonObject> Props = Ed->GetObjectField("Properties");
+
+			if (Props->TryGetObjectField("StaticParameters", StaticParams)) {
+				Local_StaticParameterObjects.Append(StaticParams->Get()->GetArrayField("StaticSwitchParameters"));
+				Local_StaticComponentMaskParametersObjects.Append(StaticParams->Get()->GetArrayField("StaticComponentMaskParameters"));
+			}
+		}
+	} else if (Properties->TryGetObjectField("StaticParameters", StaticParams)) {
+		Local_StaticParameterObjects = StaticParams->Get()->GetArrayField("StaticSwitchParameters");
+	}
+
+	for (const TSharedPtr<FJsonValue> StaticParameter_Value : Local_StaticParameterObjects) {
+		StaticSwitchParameterBinder.Apply(StaticParameter_Value->AsObject(), Instance.StaticSwitchParameters.AddDefaulted_GetRef());
+	}
+
+	for (const TSharedPtr<FJsonValue> StaticParameter_Value : Local_StaticComponentMaskParametersObjects) {
+		StaticComponentMaskParameterBinder.Apply(StaticParameter_Value->AsObject(), Instance.StaticComponentMaskParameters.AddDefaulted_GetRef());
+	}
+
+	CheckParameterNames(Instance.ScalarParameterValues, TEXT("Scalar"), Instance.Errors);
+	CheckParameterNames(Instance.VectorParameterValues, TEXT("Vector"), Instance.Errors);
+	CheckParameterNames(Instance.TextureParameterValues, TEXT("Texture"), Instance.Errors);
+	CheckParameterNames(Instance.StaticSwitchParameters, TEXT("Static switch"), Instance.Errors);
+	CheckParameterNames(Instance.StaticComponentMaskParameters, TEXT("Static component mask"), Instance.Errors);
+
+	return Instance;
+}
+
+// Reports parameters the parent doesn't have, merged for every instance of the parent
+template <typename TParameter>
+static void CheckParentParameters(const TArray<TParameter>& Parameters, const TSet<FName>& ParentNames, const FMaterialInstanceBatchParent& BatchParent, const FString& AssetName) {
+	for (const TParameter& Parameter : Parameters) {
+		if (Parameter.ParameterInfo.Association != GlobalParameter || ParentNames.Contains(Parameter.ParameterInfo.Name)) continue;
+
+		FImportDiagnostics::Get().Warning(EImportDiagnosticCategory::InvalidData, "Not a parameter of " + BatchParent.Parent->GetPathName() + ": " + Parameter.ParameterInfo.Name.ToString(), AssetName);
+	}
+}
+
 bool UMaterialInstanceConstantImporter::ImportData() {
 	try {
 		TSharedPtr<FJsonObject> Properties = JsonObject->GetObjectField("Properties");
 
-		UMaterialInstanceConstant* MaterialInstanceConstant = NewObject<UMaterialInstanceConstant>(Package, UMaterialInstanceConstant::StaticClass(), *FileName, RF_Public | RF_Standalone);
-		HandleAssetCreation(MaterialInstanceConstant);
-
 		TArray<TSharedPtr<FJsonObject>> EditorOnlyData;
-		GetObjectSerializer()->DeserializeObjectProperties(Properties, MaterialInstanceConstant);
 
 		for (const TSharedPtr<FJsonValue> Value : AllJsonObjects) {
 			TSharedPtr<FJsonObject> Object = TSharedPtr(Value->AsObject());
@@ -26,213 +167,246 @@ bool UMaterialInstanceConstantImporter::ImportData() {
 			}
 		}
 
-		if (const TSharedPtr<FJsonObject>* ParentPtr; Properties->TryGetObjectField("Parent", ParentPtr))
-			LoadObject(ParentPtr, MaterialInstanceConstant->Parent);
+		// Read every parameter before the instance is created
+		FMaterialInstanceIR Instance = BuildParameterIR(Properties, EditorOnlyData);
+
+		if (Instance.Errors.Num() > 0) {
+			for (const FString& Error : Instance.Errors) {
+				FImportDiagnostics::Get().Error(EImportDiagnosticCategory::InvalidData, Error, FileName);
+			}
+
+			return false;
+		}
+
+		// The parameters of a batch's parent are listed once, and checked here
+		if (BatchParent != nullptr && BatchParent->bHasLayout) {
+			CheckParentParameters(Instance.ScalarParameterValues, BatchParent->ScalarNames, *BatchParent, FileName);
+			CheckParentParameters(Instance.VectorParameterValues, BatchParent->VectorNames, *BatchParent, FileName);
+			CheckParentParameters(Instance.TextureParameterValues, BatchParent->TextureNames, *BatchParent, FileName);
+			CheckParentParameters(Instance.StaticSwitchParameters, BatchParent->StaticSwitchNames, *BatchParent, FileName);
+			CheckParentParameters(Instance.StaticComponentMaskParameters, BatchParent->StaticComponentMaskNames, *BatchParent, FileName);
+		}
+
+		UMaterialInstanceConstant* MaterialInstanceConstant = NewObject<UMaterialInstanceConstant>(Package, UMaterialInstanceConstant::StaticClass(), *FileName, RF_Public | RF_Standalone);
+		HandleAssetCreation(MaterialInstanceConstant);
+
+		// Parent and parameters are set directly below
+		TSharedPtr<FJsonObject> ParentObject;
+		if (const TSharedPtr<FJsonObject>* ParentPtr; Properties->TryGetObjectField("Parent", ParentPtr)) ParentObject = *ParentPtr;
+
+		GetObjectSerializer()->DeserializeObjectProperties(RemovePropertiesShared(Properties, {
+			"Parent",
+			"ScalarParameterValues",
+			"VectorParameterValues",
+			"TextureParameterValues",
+			"StaticParameters",
+			"StaticParametersRuntime"
+		}), MaterialInstanceConstant);
+
+		if (BatchParent != nullptr)
+			MaterialInstanceConstant->Parent = BatchParent->Parent;
+		else if (ParentObject.IsValid())
+			LoadObject(&ParentObject, MaterialInstanceConstant->Parent);
 		if (const TSharedPtr<FJsonObject>* SubsurfaceProfilePtr; Properties->TryGetObjectField("SubsurfaceProfile", SubsurfaceProfilePtr))
 			LoadObject(SubsurfaceProfilePtr, MaterialInstanceConstant->SubsurfaceProfile);
 		if (bool bOverrideSubsurfaceProfile; Properties->TryGetBoolField("bOverrideSubsurfaceProfile", bOverrideSubsurfaceProfile))
 			MaterialInstanceConstant->bOverrideSubsurfaceProfile = bOverrideSubsurfaceProfile;
 
-		TArray<FScalarParameterValue> ScalarParameterValues;
-		TArray<TSharedPtr<FJsonValue>> Scalars = Properties->GetArrayField("ScalarParameterValues");
-
-		for (int32 i = 0; i < Scalars.Num(); i++) {
-			TSharedPtr<FJsonObject> Scalar = Scalars[i]->AsObject();
-
-			FScalarParameterValue Parameter;
-			Parameter.ParameterValue = Scalar->GetNumberField("ParameterValue");
-			Parameter.ExpressionGUID = FGuid(Scalar->GetStringField("ExpressionGUID"));
-			
-			if (const TSharedPtr<FJsonObject>* ParameterInfoPtr; Scalar->TryGetObjectField("ParameterInfo", ParameterInfoPtr)) {
-				TSharedPtr<FJsonObject> ParameterInfoJson = Scalar->GetObjectField("ParameterInfo");
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = ParameterInfoJson->GetIntegerField("Index");
-				ParameterInfo.Name = FName(ParameterInfoJson->GetStringField("Name"));
-				ParameterInfo.Association = GlobalParameter;
-
-				Parameter.ParameterInfo = ParameterInfo;
-			} else {
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = -1;
-				ParameterInfo.Name = FName(Scalar->GetStringField("ParameterName"));
-				ParameterInfo.Association = GlobalParameter;
-
-				Parameter.ParameterInfo = ParameterInfo;
+		// Textures are the only parameters that need loading
+		for (int32 Index = 0; Index < Instance.TextureParameterValues.Num(); Index++) {
+			if (Instance.TextureReferences[Index].IsValid()) {
+				LoadObject(&Instance.TextureReferences[Index], Instance.TextureParameterValues[Index].ParameterValue);
 			}
+		}
+
+		MaterialInstanceConstant->ScalarParameterValues = MoveTemp(Instance.ScalarParameterValues);
+		MaterialInstanceConstant->VectorParameterValues = MoveTemp(Instance.VectorParameterValues);
+		MaterialInstanceConstant->TextureParameterValues = MoveTemp(Instance.TextureParameterValues);
+
+		// --------- STATIC PARAMETERS -----------
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
+		FStaticParameterSet NewStaticParameterSet; // Unreal Engine 5.2 and beyond have a different method
+		NewStaticParameterSet.StaticSwitchParameters = Instance.StaticSwitchParameters;
+		NewStaticParameterSet.EditorOnly.StaticComponentMaskParameters = Instance.StaticComponentMaskParameters;
+#else
+		MaterialInstanceConstant->GetEditorOnlyData()->StaticParameters.StaticSwitchParameters.Append(Instance.StaticSwitchParameters);
+		MaterialInstanceConstant->GetEditorOnlyData()->StaticParameters.StaticComponentMaskParameters.Append(Instance.StaticComponentMaskParameters);
+#endif
 
-			ScalarParameterValues.Add(Parameter);
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
+		if (FImportSession::Get().IsDeferringMaterialUpdates()) {
+			FImportSession::Get().DeferStaticPermutationUpdate(MaterialInstanceConstant, NewStaticParameterSet);
+		} else {
+			FMaterialUpdateContext MaterialUpdateContext(FMaterialUpdateContext::EOptions::Default & ~FMaterialUpdateContext::EOptions::RecreateRenderStates);
+	
+			MaterialInstanceConstant->UpdateStaticPermutation(NewStaticParameterSet, &MaterialUpdateContext);
+			MaterialInstanceConstant->InitStaticPermutation();
 		}
+#endif
 
-		MaterialInstanceConstant->ScalarParameterValues = ScalarParameterValues;
-		TArray<FVectorParameterValue> VectorParameterValues;
+		return OnAssetCreation(MaterialInstanceConstant);
+	} catch (const char* Exception) {
+		UE_LOG(LogJson, Error, TEXT("%s"), *FString(Exception));
+	}
 
-		TArray<TSharedPtr<FJsonValue>> Vectors = Properties->GetArrayField("VectorParameterValues");
-		for (int32 i = 0; i < Vectors.Num(); i++) {
-			TSharedPtr<FJsonObject> Vector = Vectors[i]->AsObject();
+	return false;
+}
 
-			FVectorParameterValue Parameter;
-			Parameter.ExpressionGUID = FGuid(Vector->GetStringField("ExpressionGUID"));
+bool UMaterialInstanceConstantImporter::IsInstanceFile(const TArray<TSharedPtr<FJsonValue>>& Exports) {
+	int32 Instances = 0;
 
-			Parameter.ParameterValue = FMathUtilities::ObjectToLinearColor(Vector->GetObjectField("ParameterValue").Get());
+	for (const TSharedPtr<FJsonValue>& Export : Exports) {
+		const FString Type = Export->AsObject()->GetStringField(TEXT("Type"));
 
-			if (const TSharedPtr<FJsonObject>* ParameterInfoPtr; Vector->TryGetObjectField("ParameterInfo", ParameterInfoPtr)) {
-				TSharedPtr<FJsonObject> ParameterInfoJson = Vector->GetObjectField("ParameterInfo");
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = ParameterInfoJson->GetIntegerField("Index");
-				ParameterInfo.Name = FName(ParameterInfoJson->GetStringField("Name"));
-				ParameterInfo.Association = GlobalParameter;
+		if (Type == "MaterialInstanceConstant") Instances++;
+		else if (CanImport(Type)) return false;
+	}
 
-				Parameter.ParameterInfo = ParameterInfo;
-			} else {
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = -1;
-				ParameterInfo.Name = FName(Vector->GetStringField("ParameterName"));
-				ParameterInfo.Association = GlobalParameter;
+	return Instances == 1;
+}
 
-				Parameter.ParameterInfo = ParameterInfo;
-			}
+static FMaterialInstanceBatchParent ListParentParameters(UMaterialInterface* Parent) {
+	FMaterialInstanceBatchParent BatchParent;
+	BatchParent.Parent = Parent;
 
-			VectorParameterValues.Add(Parameter);
-		}
+	if (Parent == nullptr) return BatchParent;
 
-		MaterialInstanceConstant->VectorParameterValues = VectorParameterValues;
-		TArray<FTextureParameterValue> TextureParameterValues;
+	// Parents created during this import haven't built their parameter data yet
+	if (Parent->GetOutermost()->IsDirty()) {
+		FImportDiagnostics::Get().Warning(EImportDiagnosticCategory::MissingData, "Parameters not checked against a parent modified during this import", Parent->GetName());
 
-		TArray<TSharedPtr<FJsonValue>> Textures = Properties->GetArrayField("TextureParameterValues");
-		for (int32 i = 0; i < Textures.Num(); i++) {
-			TSharedPtr<FJsonObject> Texture = Textures[i]->AsObject();
+		return BatchParent;
+	}
 
-			FTextureParameterValue Parameter;
-			Parameter.ExpressionGUID = FGuid(Texture->GetStringField("ExpressionGUID"));
+	auto ListNames = [Parent](const EMaterialParameterType Type, TSet<FName>& OutNames) {
+		TArray<FMaterialParameterInfo> ParameterInfos;
+		TArray<FGuid> ParameterIds;
+		Parent->GetAllParameterInfoOfType(Type, ParameterInfos, ParameterIds);
 
-			const TSharedPtr<FJsonObject>* TexturePtr = nullptr;
-			if (Texture->TryGetObjectField("ParameterValue", TexturePtr) && TexturePtr != nullptr) {
-				LoadObject(TexturePtr, Parameter.ParameterValue);
-			}
+		for (const FMaterialParameterInfo& ParameterInfo : ParameterInfos) {
+			OutNames.Add(ParameterInfo.Name);
+		}
+	};
 
-			if (const TSharedPtr<FJsonObject>* ParameterInfoPtr; Texture->TryGetObjectField("ParameterInfo", ParameterInfoPtr)) {
-				TSharedPtr<FJsonObject> ParameterInfoJson = Texture->GetObjectField("ParameterInfo");
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = ParameterInfoJson->GetIntegerField("Index");
-				ParameterInfo.Name = FName(ParameterInfoJson->GetStringField("Name"));
-				ParameterInfo.Association = GlobalParameter;
-
-				Parameter.ParameterInfo = ParameterInfo;
-			} else {
-				FMaterialParameterInfo ParameterInfo;
-				ParameterInfo.Index = -1;
-				ParameterInfo.Name = FName(Texture->GetStringField("ParameterName"));
-				ParameterInfo.Association = GlobalParameter;
-
-				Parameter.ParameterInfo = ParameterInfo;
+	ListNames(EMaterialParameterType::Scalar, BatchParent.ScalarNames);
+	ListNames(EMaterialParameterType::Vector, BatchParent.VectorNames);
+	ListNames(EMaterialParameterType::Texture, BatchParent.TextureNames);
+	ListNames(EMaterialParameterType::StaticSwitch, BatchParent.StaticSwitchNames);
+	ListNames(EMaterialParameterType::StaticComponentMask, BatchParent.StaticComponentMaskNames);
+
+	BatchParent.bHasLayout = true;
+
+	return BatchParent;
+}
+
+void UMaterialInstanceConstantImporter::ImportBatch(const TArray<FString>& Files, const TArray<TArray<TSharedPtr<FJsonValue>>>& FileExports) {
+	FScopedImportSession ImportSession;
+	FScopedMaterialUpdateDeferral MaterialUpdateDeferral;
+
+	// Read from the JSON only, importers are created once their group is imported
+	struct FBatchInstance {
+		int32 FileIndex;
+		TSharedPtr<FJsonObject> Export;
+		TSharedPtr<FJsonObject> Parent;
+
+		FString Name;
+		FString File;
+
+		// ObjectPath.ObjectName of the instance, and of its parent
+		FString Key;
+		FString ParentKey;
+	};
+
+	TArray<FBatchInstance> Instances;
+
+	for (int32 Index = 0; Index < Files.Num(); Index++) {
+		for (const TSharedPtr<FJsonValue>& Export : FileExports[Index]) {
+			const TSharedPtr<FJsonObject> DataObject = Export->AsObject();
+			if (DataObject->GetStringField(TEXT("Type")) != "MaterialInstanceConstant") continue;
+
+			FBatchInstance& Instance = Instances.AddDefaulted_GetRef();
+			Instance.FileIndex = Index;
+			Instance.Export = DataObject;
+			Instance.Name = DataObject->GetStringField(TEXT("Name"));
+			Instance.File = FPaths::IsRelative(Files[Index]) ? FPaths::ConvertRelativePathToFull(Files[Index]) : Files[Index];
+
+			// The package is found again when the instance is imported
+			UPackage* OutermostPkg;
+			FAssetUtilities::CreateAssetPackage(Instance.Name, Instance.File, OutermostPkg);
+			Instance.Key = OutermostPkg->GetName() + "." + Instance.Name;
+
+			if (const TSharedPtr<FJsonObject>* ParentPtr; DataObject->GetObjectField(TEXT("Properties"))->TryGetObjectField(TEXT("Parent"), ParentPtr)) {
+				FString ParentName, ParentPath;
+				ParentPtr->Get()->GetStringField(TEXT("ObjectName")).Split("'", nullptr, &ParentName);
+				ParentPtr->Get()->GetStringField(TEXT("ObjectPath")).Split(".", &ParentPath, nullptr);
+
+				Instance.Parent = *ParentPtr;
+				Instance.ParentKey = NormalizeObjectPath(ParentPath) + "." + ParentName.Replace(TEXT("'"), TEXT(""));
 			}
 
-			TextureParameterValues.Add(Parameter);
+			break;
 		}
+	}
 
-		MaterialInstanceConstant->TextureParameterValues = TextureParameterValues;
+	// Parent --> Instances of it
+	TMap<FString, TArray<int32>> Groups;
+	TSet<FString> Pending;
+
+	for (int32 Index = 0; Index < Instances.Num(); Index++) {
+		Groups.FindOrAdd(Instances[Index].ParentKey).Add(Index);
+		Pending.Add(Instances[Index].Key);
+	}
 
-		TArray<TSharedPtr<FJsonValue>> Local_StaticParameterObjects;
-		TArray<TSharedPtr<FJsonValue>> Local_StaticComponentMaskParametersObjects;
-		const TSharedPtr<FJsonObject>* StaticParams;
+	auto ImportGroup = [&Instances, &Pending, &FileExports](const TArray<int32>& Group) {
+		FMaterialInstanceBatchParent BatchParent;
+		bool bParentResolved = false;
 
-		if (Properties->TryGetObjectField("StaticParametersRuntime", StaticParams)) {
-			Local_StaticParameterObjects = StaticParams->Get()->GetArrayField("StaticSwitchParameters");
-		} else if (EditorOnlyData.Num() > 0) {
-			for (TSharedPtr<FJsonObject> Ed : EditorOnlyData) {
-				const TSharedPtr<FJsonObject> Props = Ed->GetObjectField("Properties");
+		for (const int32 Index : Group) {
+			const FBatchInstance& Instance = Instances[Index];
 
-				if (Props->TryGetObjectField("StaticParameters", StaticParams)) {
-					for (TSharedPtr<FJsonValue> Parameter : StaticParams->Get()->GetArrayField("StaticSwitchParameters")) {
-						Local_StaticParameterObjects.Add(TSharedPtr(Parameter));
-					}
+			// Each importer holds its own serializers, so only one lives at a time
+			UPackage* OutermostPkg;
+			UPackage* Package = FAssetUtilities::CreateAssetPackage(Instance.Name, Instance.File, OutermostPkg);
+			const TUniquePtr<UMaterialInstanceConstantImporter> Importer = MakeUnique<UMaterialInstanceConstantImporter>(Instance.Name, Instance.File, Instance.Export, Package, OutermostPkg, FileExports[Instance.FileIndex]);
 
-					for (TSharedPtr<FJsonValue> Parameter : StaticParams->Get()->GetArrayField("StaticComponentMaskParameters")) {
-						Local_StaticComponentMaskParametersObjects.Add(TSharedPtr(Parameter));
-					}
+			// Resolved once, through the first instance, importing the parent if it's missing
+			if (!bParentResolved) {
+				bParentResolved = true;
+
+				if (Instance.Parent.IsValid()) {
+					TObjectPtr<UMaterialInterface> Parent;
+					Importer->LoadObject(&Instance.Parent, Parent);
+
+					BatchParent = ListParentParameters(Parent);
 				}
 			}
-		} else if (Properties->TryGetObjectField("StaticParameters", StaticParams)) {
-			Local_StaticParameterObjects = StaticParams->Get()->GetArrayField("StaticSwitchParameters");
-		}
 
-		// --------- STATIC PARAMETERS -----------
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
-		FStaticParameterSet NewStaticParameterSet; // Unreal Engine 5.2 and beyond have a different method
-#endif
+			Importer->BatchParent = &BatchParent;
+
+			if (Importer->ImportData()) {
+				UE_LOG(LogJson, Log, TEXT("Successfully imported \"%s\" as \"MaterialInstanceConstant\""), *Importer->FileName);
+				Importer->SavePackage();
+
+				FImportDiagnostics::Get().Info(EImportDiagnosticCategory::Imported, "Imported MaterialInstanceConstant", Importer->FileName);
+			} else FImportDiagnostics::Get().Error(EImportDiagnosticCategory::ImportFailed, "Import Failed: MaterialInstanceConstant", Importer->FileName);
 
-		TArray<FStaticSwitchParameter> StaticSwitchParameters;
-		for (const TSharedPtr<FJsonValue> StaticParameter_Value : Local_StaticParameterObjects) {
-			TSharedPtr<FJsonObject> ParameterObject = StaticParameter_Value->AsObject();
-			TSharedPtr<FJsonObject> Local_MaterialParameterInfo = ParameterObject->GetObjectField("ParameterInfo");
-
-			// Create Material Parameter Info
-			FMaterialParameterInfo MaterialParameterParameterInfo = FMaterialParameterInfo(
-				FName(Local_MaterialParameterInfo->GetStringField("Name")),
-				static_cast<EMaterialParameterAssociation>(StaticEnum<EMaterialParameterAssociation>()->GetValueByNameString(Local_MaterialParameterInfo->GetStringField("Association"))),
-				Local_MaterialParameterInfo->GetIntegerField("Index")
-			);
-
-			// Now, create the actual switch parameter
-			FStaticSwitchParameter Parameter = FStaticSwitchParameter(
-				MaterialParameterParameterInfo,
-				ParameterObject->GetBoolField("Value"),
-				ParameterObject->GetBoolField("bOverride"),
-				FGuid(ParameterObject->GetStringField("ExpressionGUID"))
-			);
-
-			StaticSwitchParameters.Add(Parameter);
-			#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 2
-				MaterialInstanceConstant->GetEditorOnlyData()->StaticParameters.StaticSwitchParameters.Add(Parameter);
-			#endif
-			#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
-				// Unreal Engine 5.2 and beyond have a different method
-				NewStaticParameterSet.StaticSwitchParameters.Add(Parameter); 
-			#endif
+			Pending.Remove(Instance.Key);
 		}
+	};
 
-		TArray<FStaticComponentMaskParameter> StaticSwitchMaskParameters;
-		for (const TSharedPtr<FJsonValue> StaticParameter_Value : Local_StaticComponentMaskParametersObjects) {
-			TSharedPtr<FJsonObject> ParameterObject = StaticParameter_Value->AsObject();
-			TSharedPtr<FJsonObject> Local_MaterialParameterInfo = ParameterObject->GetObjectField("ParameterInfo");
-
-			// Create Material Parameter Info
-			FMaterialParameterInfo MaterialParameterParameterInfo = FMaterialParameterInfo(
-				FName(Local_MaterialParameterInfo->GetStringField("Name")),
-				static_cast<EMaterialParameterAssociation>(StaticEnum<EMaterialParameterAssociation>()->GetValueByNameString(Local_MaterialParameterInfo->GetStringField("Association"))),
-				Local_MaterialParameterInfo->GetIntegerField("Index")
-			);
-
-			FStaticComponentMaskParameter Parameter = FStaticComponentMaskParameter(
-				MaterialParameterParameterInfo,
-				ParameterObject->GetBoolField("R"),
-				ParameterObject->GetBoolField("G"),
-				ParameterObject->GetBoolField("B"),
-				ParameterObject->GetBoolField("A"),
-				ParameterObject->GetBoolField("bOverride"),
-				FGuid(ParameterObject->GetStringField("ExpressionGUID"))
-			);
-
-			StaticSwitchMaskParameters.Add(Parameter);
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 2
-			MaterialInstanceConstant->GetEditorOnlyData()->StaticParameters.StaticComponentMaskParameters.Add(Parameter);
-#endif
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
-			NewStaticParameterSet.EditorOnly.StaticComponentMaskParameters.Add(Parameter);
-#endif
+	// Groups whose parent is still waiting in the batch go after it
+	while (Groups.Num() > 0) {
+		TArray<FString> Ready;
+
+		for (const TPair<FString, TArray<int32>>& Group : Groups) {
+			if (!Pending.Contains(Group.Key)) Ready.Add(Group.Key);
 		}
 
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
-		FMaterialUpdateContext MaterialUpdateContext(FMaterialUpdateContext::EOptions::Default & ~FMaterialUpdateContext::EOptions::RecreateRenderStates);
-	
-		MaterialInstanceConstant->UpdateStaticPermutation(NewStaticParameterSet, &MaterialUpdateContext);
-		MaterialInstanceConstant->InitStaticPermutation();
-#endif
+		// Instances parented to each other in a loop, nothing can go first
+		if (Ready.Num() == 0) Groups.GetKeys(Ready);
 
-		return OnAssetCreation(MaterialInstanceConstant);
-	} catch (const char* Exception) {
-		UE_LOG(LogJson, Error, TEXT("%s"), *FString(Exception));
+		for (const FString& ParentKey : Ready) {
+			ImportGroup(Groups.FindAndRemoveChecked(ParentKey));
+		}
 	}
-
-	return false;
 }
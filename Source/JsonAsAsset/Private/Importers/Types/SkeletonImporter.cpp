@@ -8,6 +8,7 @@
 #include "Factories/TextureFactory.h"
 #include "Utilities/AssetUtilities.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/PropertyBinder.h"
 
 bool USkeletonAssetDerived::AddVirtualBone(const FName SourceBoneName, const FName TargetBoneName, const FName VirtualBoneRootName) {
 	for (const FVirtualBone& SSBone : VirtualBones) {
@@ -132,15 +133,13 @@ bool USkeletonImporter::ImportData() {
 					}
 
 					if (!bIsAlreadyCreated) {
-						if (const TSharedPtr<FJsonObject>* RelativeRotationObjectRotator; SecondaryPurposeProperties->TryGetObjectField("RelativeRotation", RelativeRotationObjectRotator) == true)
-							Socket->RelativeRotation = FMathUtilities::ObjectToRotator(RelativeRotationObjectRotator->Get());
-						if (const TSharedPtr<FJsonObject>* RelativeLocationObjectVector; SecondaryPurposeProperties->TryGetObjectField("RelativeLocation", RelativeLocationObjectVector) == true)
-							Socket->RelativeLocation = FMathUtilities::ObjectToVector(RelativeLocationObjectVector->Get());
-						if (const TSharedPtr<FJsonObject>* RelativeScaleObjectVector; SecondaryPurposeProperties->TryGetObjectField("RelativeScale", RelativeScaleObjectVector) == true)
-							Socket->RelativeScale = FMathUtilities::ObjectToVector(RelativeScaleObjectVector->Get());
-
-						if (bool bForceAlwaysAnimated; SecondaryPurposeProperties->TryGetBoolField("RelativeScale", bForceAlwaysAnimated) == true)
-							Socket->bForceAlwaysAnimated = bForceAlwaysAnimated;
+						static const TPropertyBinder<USkeletalMeshSocket> SocketBinder = TPropertyBinder<USkeletalMeshSocket>()
+							.Bind(TEXT("RelativeRotation"), &USkeletalMeshSocket::RelativeRotation)
+							.Bind(TEXT("RelativeLocation"), &USkeletalMeshSocket::RelativeLocation)
+							.Bind(TEXT("RelativeScale"), &USkeletalMeshSocket::RelativeScale)
+							.Bind(TEXT("bForceAlwaysAnimated"), &USkeletalMeshSocket::bForceAlwaysAnimated);
+
+						SocketBinder.Apply(SecondaryPurposeProperties, *Socket);
 
 						Skeleton->Modify();
 						Skeleton->Sockets.Add(Socket);
@@ -10,6 +10,7 @@
 #include "nvimage/DirectDrawSurface.h"
 #include "nvimage/Image.h"
 #include "Utilities/MathUtilities.h"
+#include "Utilities/PropertyBinder.h"
 #include "Utilities/TextureDecode/TextureNVTT.h"
 
 bool UTextureImporter::ImportTexture2D(UTexture*& OutTexture2D, TArray<uint8>& Data, const TSharedPtr<FJsonObject>& Properties) const {
@@ -127,28 +128,23 @@ bool UTextureImporter::ImportRenderTarget2D(UTexture*& OutRenderTarget2D, const
 
 	ImportTexture_Data(RenderTarget2D, Properties);
 
-	int SizeX;
-	if (Properties->TryGetNumberField(TEXT("SizeX"), SizeX)) RenderTarget2D->SizeX = SizeX;
-	int SizeY;
-	if (Properties->TryGetNumberField(TEXT("SizeY"), SizeY)) RenderTarget2D->SizeY = SizeY;
-
-	FString AddressX;
-	if (Properties->TryGetStringField(TEXT("AddressX"), AddressX)) RenderTarget2D->AddressX = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressX));
-	FString AddressY;
-	if (Properties->TryGetStringField(TEXT("AddressY"), AddressY)) RenderTarget2D->AddressY = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressY));
-	FString RenderTargetFormat;
-	if (Properties->TryGetStringField(TEXT("RenderTargetFormat"), RenderTargetFormat)) RenderTarget2D->RenderTargetFormat = static_cast<ETextureRenderTargetFormat>(StaticEnum<ETextureRenderTargetFormat>()->GetValueByNameString(RenderTargetFormat));
-
-	bool bAutoGenerateMips;
-	if (Properties->TryGetBoolField(TEXT("bAutoGenerateMips"), bAutoGenerateMips)) RenderTarget2D->bAutoGenerateMips = bAutoGenerateMips;
-	if (bAutoGenerateMips) {
-		if (FString MipsSamplerFilter; Properties->TryGetStringField(TEXT("MipsSamplerFilter"), MipsSamplerFilter))
-			RenderTarget2D->MipsSamplerFilter = static_cast<TextureFilter>(StaticEnum<TextureFilter>()->GetValueByNameString(MipsSamplerFilter));
+	static const TPropertyBinder<UTextureRenderTarget2D> RenderTargetBinder = TPropertyBinder<UTextureRenderTarget2D>()
+		.Bind(TEXT("SizeX"), &UTextureRenderTarget2D::SizeX)
+		.Bind(TEXT("SizeY"), &UTextureRenderTarget2D::SizeY)
+		.Bind(TEXT("AddressX"), &UTextureRenderTarget2D::AddressX)
+		.Bind(TEXT("AddressY"), &UTextureRenderTarget2D::AddressY)
+		.Bind(TEXT("RenderTargetFormat"), &UTextureRenderTarget2D::RenderTargetFormat)
+		.BindBool(TEXT("bAutoGenerateMips"), [](UTextureRenderTarget2D& RenderTarget, const bool bValue) { RenderTarget.bAutoGenerateMips = bValue; })
+		.Bind(TEXT("MipsSamplerFilter"), &UTextureRenderTarget2D::MipsSamplerFilter)
+		.Bind(TEXT("ClearColor"), &UTextureRenderTarget2D::ClearColor);
+
+	RenderTargetBinder.Apply(Properties, *RenderTarget2D);
+
+	// Sampler filter is only used with generated mips
+	if (!RenderTarget2D->bAutoGenerateMips) {
+		RenderTarget2D->MipsSamplerFilter = GetDefault<UTextureRenderTarget2D>()->MipsSamplerFilter;
 	}
 
-	const TSharedPtr<FJsonObject>* ClearColor;
-	if (Properties->TryGetObjectField(TEXT("ClearColor"), ClearColor)) RenderTarget2D->ClearColor = FMathUtilities::ObjectToLinearColor(ClearColor->Get());
-
 	if (RenderTarget2D) {
 		OutRenderTarget2D = RenderTarget2D;
 		return true;
@@ -163,20 +159,22 @@ bool UTextureImporter::ImportTexture2D_Data(UTexture2D* InTexture2D, const TShar
 
 	ImportTexture_Data(InTexture2D, Properties);
 
-	if (FString AddressX; Properties->TryGetStringField(TEXT("AddressX"), AddressX)) InTexture2D->AddressX = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressX));
-	if (FString AddressY; Properties->TryGetStringField(TEXT("AddressY"), AddressY)) InTexture2D->AddressY = static_cast<TextureAddress>(StaticEnum<TextureAddress>()->GetValueByNameString(AddressY));
-	if (bool bHasBeenPaintedInEditor; Properties->TryGetBoolField(TEXT("bHasBeenPaintedInEditor"), bHasBeenPaintedInEditor)) InTexture2D->bHasBeenPaintedInEditor = bHasBeenPaintedInEditor;
-
-	// --------- Platform Data --------- //
-	FTexturePlatformData* PlatformData = InTexture2D->GetPlatformData();
+	static const TPropertyBinder<UTexture2D> Texture2DBinder = TPropertyBinder<UTexture2D>()
+		.Bind(TEXT("AddressX"), &UTexture2D::AddressX)
+		.Bind(TEXT("AddressY"), &UTexture2D::AddressY)
+		.BindBool(TEXT("bHasBeenPaintedInEditor"), [](UTexture2D& Texture, const bool bValue) { Texture.bHasBeenPaintedInEditor = bValue; })
+		.Bind(TEXT("FirstResourceMemMip"), &UTexture2D::FirstResourceMemMip)
+		.Bind(TEXT("LevelIndex"), &UTexture2D::LevelIndex)
 
-	if (int SizeX; Properties->TryGetNumberField(TEXT("SizeX"), SizeX)) PlatformData->SizeX = SizeX;
-	if (int SizeY; Properties->TryGetNumberField(TEXT("SizeY"), SizeY)) PlatformData->SizeY = SizeY;
-	if (uint32 PackedData; Properties->TryGetNumberField(TEXT("PackedData"), PackedData)) PlatformData->PackedData = PackedData;
-	if (FString PixelFormat; Properties->TryGetStringField(TEXT("PixelFormat"), PixelFormat)) PlatformData->PixelFormat = static_cast<EPixelFormat>(InTexture2D->GetPixelFormatEnum()->GetValueByNameString(PixelFormat));
+		// --------- Platform Data --------- //
+		.Bind(TEXT("SizeX"), [](UTexture2D& Texture, const FJsonValue& Value) { JsonBinding::ReadValue(Value, Texture.GetPlatformData()->SizeX); })
+		.Bind(TEXT("SizeY"), [](UTexture2D& Texture, const FJsonValue& Value) { JsonBinding::ReadValue(Value, Texture.GetPlatformData()->SizeY); })
+		.Bind(TEXT("PackedData"), [](UTexture2D& Texture, const FJsonValue& Value) { JsonBinding::ReadValue(Value, Texture.GetPlatformData()->PackedData); })
+		.Bind(TEXT("PixelFormat"), [](UTexture2D& Texture, const FJsonValue& Value) {
+			Texture.GetPlatformData()->PixelFormat = static_cast<EPixelFormat>(UTexture::GetPixelFormatEnum()->GetValueByNameString(Value.AsString()));
+		});
 
-	if (int FirstResourceMemMip; Properties->TryGetNumberField(TEXT("FirstResourceMemMip"), FirstResourceMemMip)) InTexture2D->FirstResourceMemMip = FirstResourceMemMip;
-	if (int LevelIndex; Properties->TryGetNumberField(TEXT("LevelIndex"), LevelIndex)) InTexture2D->LevelIndex = LevelIndex;
+	Texture2DBinder.Apply(Properties, *InTexture2D);
 
 	return false;
 }
@@ -185,88 +183,61 @@ bool UTextureImporter::ImportTexture2D_Data(UTexture2D* InTexture2D, const TShar
 bool UTextureImporter::ImportTexture_Data(UTexture* InTexture, const TSharedPtr<FJsonObject>& Properties) const {
 	if (InTexture == nullptr) return false;
 
-	// TODO: Replace with serializer
-	if (float AdjustBrightness; Properties->TryGetNumberField(TEXT("AdjustBrightness"), AdjustBrightness))
-		InTexture->AdjustBrightness = AdjustBrightness;
-	if (float AdjustBrightnessCurve; Properties->TryGetNumberField(TEXT("AdjustBrightnessCurve"), AdjustBrightnessCurve))
-		InTexture->AdjustBrightnessCurve = AdjustBrightnessCurve;
-	if (float AdjustHue; Properties->TryGetNumberField(TEXT("AdjustHue"), AdjustHue))
-		InTexture->AdjustHue = AdjustHue;
-	if (float AdjustMaxAlpha; Properties->TryGetNumberField(TEXT("AdjustMaxAlpha"), AdjustMaxAlpha))
-		InTexture->AdjustMaxAlpha = AdjustMaxAlpha;
-	if (float AdjustMinAlpha; Properties->TryGetNumberField(TEXT("AdjustMinAlpha"), AdjustMinAlpha))
-		InTexture->AdjustMinAlpha = AdjustMinAlpha;
-	if (float AdjustRGBCurve; Properties->TryGetNumberField(TEXT("AdjustRGBCurve"), AdjustRGBCurve))
-		InTexture->AdjustRGBCurve = AdjustRGBCurve;
-	if (float AdjustSaturation; Properties->TryGetNumberField(TEXT("AdjustSaturation"), AdjustSaturation))
-		InTexture->AdjustSaturation = AdjustSaturation;
-	if (float AdjustVibrance; Properties->TryGetNumberField(TEXT("AdjustVibrance"), AdjustVibrance))
-		InTexture->AdjustVibrance = AdjustVibrance;
-
-	if (const TSharedPtr<FJsonObject>* AlphaCoverageThresholds; Properties->TryGetObjectField(TEXT("AlphaCoverageThresholds"), AlphaCoverageThresholds))
-		InTexture->AlphaCoverageThresholds = FMathUtilities::ObjectToVector(AlphaCoverageThresholds->Get());
-
-	if (bool bChromaKeyTexture; Properties->TryGetBoolField(TEXT("bChromaKeyTexture"), bChromaKeyTexture))
-		InTexture->bChromaKeyTexture = bChromaKeyTexture;
-	if (bool bFlipGreenChannel; Properties->TryGetBoolField(TEXT("bFlipGreenChannel"), bFlipGreenChannel))
-		InTexture->bFlipGreenChannel = bFlipGreenChannel;
-	if (bool bNoTiling; Properties->TryGetBoolField(TEXT("bNoTiling"), bNoTiling))
-		InTexture->bNoTiling = bNoTiling;
-	if (bool bPreserveBorder; Properties->TryGetBoolField(TEXT("bPreserveBorder"), bPreserveBorder))
-		InTexture->bPreserveBorder = bPreserveBorder;
-	if (bool bUseLegacyGamma; Properties->TryGetBoolField(TEXT("bUseLegacyGamma"), bUseLegacyGamma))
-		InTexture->bUseLegacyGamma = bUseLegacyGamma;
-
-	if (const TSharedPtr<FJsonObject>* ChromaKeyColor; Properties->TryGetObjectField(TEXT("ChromaKeyColor"), ChromaKeyColor))
-		InTexture->ChromaKeyColor = FMathUtilities::ObjectToColor(ChromaKeyColor->Get());
-	if (float ChromaKeyThreshold; Properties->TryGetNumberField(TEXT("ChromaKeyThreshold"), ChromaKeyThreshold))
-		InTexture->ChromaKeyThreshold = ChromaKeyThreshold;
-
-	if (float CompositePower; Properties->TryGetNumberField(TEXT("CompositePower"), CompositePower))
-		InTexture->CompositePower = CompositePower;
-	if (FString CompositeTextureMode; Properties->TryGetStringField(TEXT("CompositeTextureMode"), CompositeTextureMode))
-		InTexture->CompositeTextureMode = static_cast<ECompositeTextureMode>(StaticEnum<ECompositeTextureMode>()->GetValueByNameString(CompositeTextureMode));
-
-	if (bool CompressionNoAlpha; Properties->TryGetBoolField(TEXT("CompressionNoAlpha"), CompressionNoAlpha))
-		InTexture->CompressionNoAlpha = CompressionNoAlpha;
-	if (bool CompressionNone; Properties->TryGetBoolField(TEXT("CompressionNone"), CompressionNone))
-		InTexture->CompressionNone = CompressionNone;
-	if (FString CompressionQuality; Properties->TryGetStringField(TEXT("CompressionQuality"), CompressionQuality))
-		InTexture->CompressionQuality = static_cast<ETextureCompressionQuality>(StaticEnum<ETextureCompressionQuality>()->GetValueByNameString(CompressionQuality));
-	if (FString CompressionSettings; Properties->TryGetStringField(TEXT("CompressionSettings"), CompressionSettings))
-		InTexture->CompressionSettings = static_cast<TextureCompressionSettings>(StaticEnum<TextureCompressionSettings>()->GetValueByNameString(CompressionSettings));
-	if (bool CompressionYCoCg; Properties->TryGetBoolField(TEXT("CompressionYCoCg"), CompressionYCoCg))
-		InTexture->CompressionYCoCg = CompressionYCoCg;
-	if (bool DeferCompression; Properties->TryGetBoolField(TEXT("DeferCompression"), DeferCompression))
-		InTexture->DeferCompression = DeferCompression;
-	if (FString Filter; Properties->TryGetStringField(TEXT("Filter"), Filter))
-		InTexture->Filter = static_cast<TextureFilter>(StaticEnum<TextureFilter>()->GetValueByNameString(Filter));
-
-	// TODO: Add LayerFormatSettings
-
-	if (FString LODGroup; Properties->TryGetStringField(TEXT("LODGroup"), LODGroup))
-		InTexture->LODGroup = static_cast<TextureGroup>(StaticEnum<TextureGroup>()->GetValueByNameString(LODGroup));
-	if (FString LossyCompressionAmount; Properties->TryGetStringField(TEXT("LossyCompressionAmount"), LossyCompressionAmount))
-		InTexture->LossyCompressionAmount = static_cast<ETextureLossyCompressionAmount>(StaticEnum<ETextureLossyCompressionAmount>()->GetValueByNameString(LossyCompressionAmount));
-
-	if (int MaxTextureSize; Properties->TryGetNumberField(TEXT("MaxTextureSize"), MaxTextureSize))
-		InTexture->MaxTextureSize = MaxTextureSize;
-	if (FString MipGenSettings; Properties->TryGetStringField(TEXT("MipGenSettings"), MipGenSettings))
-		InTexture->MipGenSettings = static_cast<TextureMipGenSettings>(StaticEnum<TextureMipGenSettings>()->GetValueByNameString(MipGenSettings));
-	if (FString MipLoadOptions; Properties->TryGetStringField(TEXT("MipLoadOptions"), MipLoadOptions))
-		InTexture->MipLoadOptions = static_cast<ETextureMipLoadOptions>(StaticEnum<ETextureMipLoadOptions>()->GetValueByNameString(MipLoadOptions));
-
-	if (const TSharedPtr<FJsonObject>* PaddingColor; Properties->TryGetObjectField(TEXT("PaddingColor"), PaddingColor)) InTexture->PaddingColor = FMathUtilities::ObjectToColor(PaddingColor->Get());
-	if (FString PowerOfTwoMode; Properties->TryGetStringField(TEXT("PowerOfTwoMode"), PowerOfTwoMode))
-		InTexture->PowerOfTwoMode = static_cast<ETexturePowerOfTwoSetting::Type>(StaticEnum<ETexturePowerOfTwoSetting::Type>()->GetValueByNameString(PowerOfTwoMode));
-
-	if (bool SRGB; Properties->TryGetBoolField(TEXT("SRGB"), SRGB))
-		InTexture->SRGB = SRGB;
-	if (bool VirtualTextureStreaming; Properties->TryGetBoolField(TEXT("VirtualTextureStreaming"), VirtualTextureStreaming))
-		InTexture->VirtualTextureStreaming = VirtualTextureStreaming;
-
-	if (FString LightingGuid; Properties->TryGetStringField(TEXT("LightingGuid"), LightingGuid))
-		InTexture->SetLightingGuid(FGuid(LightingGuid));
+	static const TPropertyBinder<UTexture> TextureBinder = TPropertyBinder<UTexture>()
+		.Bind(TEXT("AdjustBrightness"), &UTexture::AdjustBrightness)
+		.Bind(TEXT("AdjustBrightnessCurve"), &UTexture::AdjustBrightnessCurve)
+		.Bind(TEXT("AdjustHue"), &UTexture::AdjustHue)
+		.Bind(TEXT("AdjustMaxAlpha"), &UTexture::AdjustMaxAlpha)
+		.Bind(TEXT("AdjustMinAlpha"), &UTexture::AdjustMinAlpha)
+		.Bind(TEXT("AdjustRGBCurve"), &UTexture::AdjustRGBCurve)
+		.Bind(TEXT("AdjustSaturation"), &UTexture::AdjustSaturation)
+		.Bind(TEXT("AdjustVibrance"), &UTexture::AdjustVibrance)
+
+		.Bind(TEXT("AlphaCoverageThresholds"), &UTexture::AlphaCoverageThresholds)
+
+		.BindBool(TEXT("bChromaKeyTexture"), [](UTexture& Texture, const bool bValue) { Texture.bChromaKeyTexture = bValue; })
+		.BindBool(TEXT("bFlipGreenChannel"), [](UTexture& Texture, const bool bValue) { Texture.bFlipGreenChannel = bValue; })
+		.BindBool(TEXT("bNoTiling"), [](UTexture& Texture, const bool bValue) { Texture.bNoTiling = bValue; })
+		.BindBool(TEXT("bPreserveBorder"), [](UTexture& Texture, const bool bValue) { Texture.bPreserveBorder = bValue; })
+		.BindBool(TEXT("bUseLegacyGamma"), [](UTexture& Texture, const bool bValue) { Texture.bUseLegacyGamma = bValue; })
+
+		.Bind(TEXT("ChromaKeyColor"), &UTexture::ChromaKeyColor)
+		.Bind(TEXT("ChromaKeyThreshold"), &UTexture::ChromaKeyThreshold)
+
+		.Bind(TEXT("CompositePower"), &UTexture::CompositePower)
+		.Bind(TEXT("CompositeTextureMode"), &UTexture::CompositeTextureMode)
+
+		.BindBool(TEXT("CompressionNoAlpha"), [](UTexture& Texture, const bool bValue) { Texture.CompressionNoAlpha = bValue; })
+		.BindBool(TEXT("CompressionNone"), [](UTexture& Texture, const bool bValue) { Texture.CompressionNone = bValue; })
+		.Bind(TEXT("CompressionQuality"), &UTexture::CompressionQuality)
+		.Bind(TEXT("CompressionSettings"), &UTexture::CompressionSettings)
+		.BindBool(TEXT("CompressionYCoCg"), [](UTexture& Texture, const bool bValue) { Texture.CompressionYCoCg = bValue; })
+		.BindBool(TEXT("DeferCompression"), [](UTexture& Texture, const bool bValue) { Texture.DeferCompression = bValue; })
+		.Bind(TEXT("Filter"), &UTexture::Filter)
+
+		// TODO: Add LayerFormatSettings
+
+		.Bind(TEXT("LODGroup"), &UTexture::LODGroup)
+		.Bind(TEXT("LossyCompressionAmount"), &UTexture::LossyCompressionAmount)
+
+		.Bind(TEXT("MaxTextureSize"), &UTexture::MaxTextureSize)
+		.Bind(TEXT("MipGenSettings"), &UTexture::MipGenSettings)
+		.Bind(TEXT("MipLoadOptions"), &UTexture::MipLoadOptions)
+
+		.Bind(TEXT("PaddingColor"), &UTexture::PaddingColor)
+		.Bind(TEXT("PowerOfTwoMode"), &UTexture::PowerOfTwoMode)
+
+		.BindBool(TEXT("SRGB"), [](UTexture& Texture, const bool bValue) { Texture.SRGB = bValue; })
+		.BindBool(TEXT("VirtualTextureStreaming"), [](UTexture& Texture, const bool bValue) { Texture.VirtualTextureStreaming = bValue; })
+
+		.Bind(TEXT("LightingGuid"), [](UTexture& Texture, const FJsonValue& Value) {
+			FGuid LightingGuid;
+			JsonBinding::ReadValue(Value, LightingGuid);
+
+			Texture.SetLightingGuid(LightingGuid);
+		});
+
+	TextureBinder.Apply(Properties, *InTexture);
 
 	return false;
 }
@@ -23,6 +23,8 @@
 
 #include "Modules/AboutJsonAsAsset.h"
 #include "Utilities/AssetUtilities.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ImportDiagnostics.h"
 // <------------------------------------------------------------------------------------------------------------
 
 #ifdef _MSC_VER
@@ -139,16 +141,14 @@ void FJsonAsAssetModule::PluginButtonClicked() {
 	if (OutFileNames.Num() == 0)
 		return;
 
-	for (FString& File : OutFileNames) {
-		// Clear Message Log
-		FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
-		TSharedRef<IMessageLogListing> LogListing = (MessageLogModule.GetLogListing("JsonAsAsset"));
-		LogListing->ClearMessages();
+	// Clear Message Log, the import is reported on a single page once done
+	FMessageLogModule& MessageLogModule = FModuleManager::GetModuleChecked<FMessageLogModule>("MessageLog");
+	TSharedRef<IMessageLogListing> LogListing = (MessageLogModule.GetLogListing("JsonAsAsset"));
+	LogListing->ClearMessages();
 
-		// Import asset by IImporter
-		IImporter* Importer = new IImporter();
-		Importer->ImportReference(File);
-	}
+	// Import every selected file in one session, sharing resolved references
+	IImporter* Importer = new IImporter();
+	Importer->ImportReferences(OutFileNames);
 }
 
 void FJsonAsAssetModule::StartupModule() {
@@ -233,6 +233,9 @@ void FJsonAsAssetModule::StartupModule() {
 }
 
 void FJsonAsAssetModule::ShutdownModule() {
+	// Report messages still waiting for their flush tick
+	FImportDiagnostics::Get().Flush();
+
 	// Unregister startup callback and tool menus
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
@@ -348,7 +351,7 @@ TSharedRef<SWidget> FJsonAsAssetModule::CreateToolbarDropdown() {
 						}
 						
 						else {
-							UClass* Class = FindObject<UClass>(nullptr, *("/Script/Engine." + Asset));
+							UClass* Class = FImportSession::Get().FindClass(Asset);
 							FText Description = Class ? Class->GetToolTipText() : FText::FromString(Asset);
 
 							InnerMenuBuilder.AddMenuEntry(
@@ -440,7 +443,7 @@ TSharedRef<SWidget> FJsonAsAssetModule::CreateToolbarDropdown() {
 						}
 						
 						else {
-							UClass* Class = FindObject<UClass>(nullptr, *("/Script/Engine." + Asset));
+							UClass* Class = FImportSession::Get().FindClass(Asset);
 							FText Description = Class ? Class->GetToolTipText() : FText::FromString(Asset);
 							
 							InnerMenuBuilder.AddMenuEntry(
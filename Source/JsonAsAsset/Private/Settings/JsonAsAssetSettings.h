@@ -7,6 +7,7 @@
 #include "CoreMinimal.h"
 #include "Engine/EngineTypes.h"
 #include "Engine/DeveloperSettings.h"
+#include "SceneTypes.h"
 
 #include "JsonAsAssetSettings.generated.h"
 
@@ -117,6 +118,41 @@ struct FParseKey
 	FString Guid;
 };
 
+// Branch kept when collapsing feature level switches
+UENUM()
+enum class EImportFeatureLevel : uint8
+{
+	ES3_1,
+	SM5,
+	SM6
+};
+
+// Branch kept when collapsing shading path switches
+UENUM()
+enum class EImportShadingPath : uint8
+{
+	Deferred,
+	Forward,
+	Mobile
+};
+
+// What to do with a material or material function identical to one imported before it
+UENUM()
+enum class EMaterialDeduplication : uint8
+{
+	// Duplicates are imported like any other asset
+	Disabled,
+
+	// Duplicates are imported, and listed in the import report
+	Report,
+
+	// Duplicates are saved as redirectors to the first identical asset
+	Redirect,
+
+	// Duplicates aren't created, references to them during the import use the first identical asset
+	Reuse
+};
+
 // Settings for materials
 USTRUCT()
 struct FMaterialImportSettings
@@ -127,6 +163,13 @@ public:
 	// Constructor to initialize default values
 	FMaterialImportSettings()
 		: bSkipResultNodeConnection(false)
+		, bDeferMaterialCompilation(true)
+		, bCollapseMaterialSwitches(false)
+		, CollapsedQualityLevel(EMaterialQualityLevel::High)
+		, CollapsedFeatureLevel(EImportFeatureLevel::SM5)
+		, CollapsedShadingPath(EImportShadingPath::Deferred)
+		, bLeanMaterialImport(false)
+		, Deduplication(EMaterialDeduplication::Disabled)
 	{}
 
 	/**
@@ -141,6 +184,55 @@ public:
 	*/
 	UPROPERTY(EditAnywhere, Config)
 	bool bSkipResultNodeConnection;
+
+	/**
+	* Skips compiling each material and material instance as it is imported,
+	* and compiles all of them together once the import is done.
+	*
+	* Instances are only compiled with their final parameters.
+	*/
+	UPROPERTY(EditAnywhere, Config)
+	bool bDeferMaterialCompilation;
+
+	/**
+	* Replaces quality, feature level and shading path switches with the branch
+	* chosen below, and removes the expressions only the other branches used.
+	*
+	* Graphs get smaller, and fewer shader permutations are compiled.
+	*/
+	UPROPERTY(EditAnywhere, Config)
+	bool bCollapseMaterialSwitches;
+
+	UPROPERTY(EditAnywhere, Config, meta = (EditCondition = "bCollapseMaterialSwitches", InvalidEnumValues = "Num"))
+	TEnumAsByte<EMaterialQualityLevel::Type> CollapsedQualityLevel;
+
+	UPROPERTY(EditAnywhere, Config, meta = (EditCondition = "bCollapseMaterialSwitches"))
+	EImportFeatureLevel CollapsedFeatureLevel;
+
+	UPROPERTY(EditAnywhere, Config, meta = (EditCondition = "bCollapseMaterialSwitches"))
+	EImportShadingPath CollapsedShadingPath;
+
+	/**
+	* Imports only what a material needs to render, for bulk imports of graphs
+	* nobody will open. Comments, reroutes and named reroutes aren't created
+	* (connections go straight through them), nodes missing in this build are
+	* only reported, and node positions aren't imported.
+	*
+	* (reroutes inside composite nodes are kept)
+	*/
+	UPROPERTY(EditAnywhere, Config)
+	bool bLeanMaterialImport;
+
+	/**
+	* Game files often contain many copies of the same material or material
+	* function, differing only in their path. Each graph is hashed while it is
+	* imported (ignoring its own path, name and GUIDs), and copies of a graph
+	* already imported in the same run are handled as set here.
+	*
+	* Duplicate groups are listed in the message log and the import report.
+	*/
+	UPROPERTY(EditAnywhere, Config)
+	EMaterialDeduplication Deduplication;
 };
 
 // Settings for sounds
@@ -162,6 +254,7 @@ public:
 	// Constructor to initialize default values
 	FAssetSettings()
 		: bSavePackagesOnImport(false)
+		, bPatchExistingAssets(false)
 	{
 		MaterialImportSettings = FMaterialImportSettings();
 		SoundImportSettings = FSoundImportSettings();
@@ -176,6 +269,16 @@ public:
 	UPROPERTY(EditAnywhere, Config, meta = (DisplayName = "Save Assets On Import"))
 	bool bSavePackagesOnImport;
 
+	/**
+	* When re-importing an asset that already exists, only write the properties
+	* that differ from the asset, instead of recreating it. Changed properties are
+	* listed in the message log.
+	*
+	* (only data assets and assets without a dedicated importer)
+	*/
+	UPROPERTY(EditAnywhere, Config)
+	bool bPatchExistingAssets;
+
 	/**
 	* Not needed for normal operations, needed for older versions of game builds.
 	*/
@@ -0,0 +1,193 @@
+// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/ImportDiagnostics.h"
+#include "Utilities/ImportSession.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonWriter.h"
+#include "Serialization/JsonSerializer.h"
+#include "Logging/MessageLog.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Framework/Application/SlateApplication.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "Widgets/Notifications/SNotificationList.h"
+
+FImportDiagnostics& FImportDiagnostics::Get() {
+	static FImportDiagnostics Diagnostics;
+	return Diagnostics;
+}
+
+const TCHAR* FImportDiagnostics::GetCategoryName(const EImportDiagnosticCategory Category) {
+	switch (Category) {
+		case EImportDiagnosticCategory::Imported: return TEXT("Imported");
+		case EImportDiagnosticCategory::Patched: return TEXT("Patched");
+		case EImportDiagnosticCategory::ImportFailed: return TEXT("ImportFailed");
+		case EImportDiagnosticCategory::MissingData: return TEXT("MissingData");
+		case EImportDiagnosticCategory::InvalidData: return TEXT("InvalidData");
+		case EImportDiagnosticCategory::MissingClass: return TEXT("MissingClass");
+		case EImportDiagnosticCategory::MissingReference: return TEXT("MissingReference");
+		case EImportDiagnosticCategory::Download: return TEXT("Download");
+		case EImportDiagnosticCategory::Duplicate: return TEXT("Duplicate");
+	}
+
+	return TEXT("Unknown");
+}
+
+static const TCHAR* GetSeverityName(const EMessageSeverity::Type Severity) {
+	switch (Severity) {
+		case EMessageSeverity::Error: return TEXT("Error");
+		case EMessageSeverity::Warning:
+		case EMessageSeverity::PerformanceWarning: return TEXT("Warning");
+		default: return TEXT("Info");
+	}
+}
+
+void FImportDiagnostics::Add(const EMessageSeverity::Type Severity, const EImportDiagnosticCategory Category, const FString& Message, const FString& AssetName) {
+	const TPair<EImportDiagnosticCategory, FString> Key(Category, Message);
+
+	int32& Index = EntryIndices.FindOrAdd(Key, INDEX_NONE);
+
+	if (Index == INDEX_NONE) {
+		Index = Entries.Num();
+		Entries.Add({ Severity, Category, Message });
+	}
+
+	FEntry& Entry = Entries[Index];
+	Entry.Count++;
+
+	// Keep the most severe of the merged messages (lower is more severe)
+	Entry.Severity = FMath::Min(Entry.Severity, Severity);
+
+	if (!AssetName.IsEmpty()) Entry.Assets.Add(AssetName);
+
+	// No session end would flush it, so flush everything added until the next tick at once
+	if (!FImportSession::Get().IsActive() && !FlushTickerHandle.IsValid()) {
+		FlushTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateLambda([](float) {
+			FImportDiagnostics& Diagnostics = Get();
+
+			Diagnostics.FlushTickerHandle.Reset();
+			Diagnostics.Flush();
+
+			return false;
+		}));
+	}
+}
+
+void FImportDiagnostics::Flush() {
+	if (FlushTickerHandle.IsValid()) {
+		FTSTicker::GetCoreTicker().RemoveTicker(FlushTickerHandle);
+		FlushTickerHandle.Reset();
+	}
+
+	if (Entries.IsEmpty()) return;
+
+	FMessageLog MessageLogger = FMessageLog(FName("JsonAsAsset"));
+	MessageLogger.NewPage(FText::FromString("Import " + FDateTime::Now().ToString()));
+
+	for (const FEntry& Entry : Entries) {
+		// Imported assets get a line each, one merged line would be unreadable for large imports
+		if (Entry.Category == EImportDiagnosticCategory::Imported && Entry.Assets.Num() > 0) {
+			for (const FString& Asset : Entry.Assets) {
+				const FString Text = Entry.Message + " (" + Asset + ")";
+
+				MessageLogger.Message(Entry.Severity, FText::FromString(Text));
+				LogEntry(Entry, Text);
+			}
+
+			continue;
+		}
+
+		FString Text = Entry.Message;
+		if (Entry.Assets.Num() > 0) Text += " (" + FString::Join(Entry.Assets, TEXT(", ")) + ")";
+
+		MessageLogger.Message(Entry.Severity, FText::FromString(Text));
+		LogEntry(Entry, Text);
+	}
+
+	WriteReport();
+	ShowSummary();
+
+	Entries.Empty();
+	EntryIndices.Empty();
+}
+
+void FImportDiagnostics::LogEntry(const FEntry& Entry, const FString& Text) const {
+	// The message log isn't shown in commandlets
+	if (!IsRunningCommandlet()) return;
+
+	switch (Entry.Severity) {
+		case EMessageSeverity::Error:
+			UE_LOG(LogJson, Error, TEXT("[%s] %s"), GetCategoryName(Entry.Category), *Text);
+			break;
+		case EMessageSeverity::Info:
+			UE_LOG(LogJson, Log, TEXT("[%s] %s"), GetCategoryName(Entry.Category), *Text);
+			break;
+		default:
+			UE_LOG(LogJson, Warning, TEXT("[%s] %s"), GetCategoryName(Entry.Category), *Text);
+			break;
+	}
+}
+
+void FImportDiagnostics::WriteReport() const {
+	TArray<TSharedPtr<FJsonValue>> EntryValues;
+	TMap<FString, int32> SeverityCounts;
+
+	for (const FEntry& Entry : Entries) {
+		const TSharedPtr<FJsonObject> EntryObject = MakeShared<FJsonObject>();
+		EntryObject->SetStringField(TEXT("Severity"), GetSeverityName(Entry.Severity));
+		EntryObject->SetStringField(TEXT("Category"), GetCategoryName(Entry.Category));
+		EntryObject->SetStringField(TEXT("Message"), Entry.Message);
+		EntryObject->SetNumberField(TEXT("Count"), Entry.Count);
+
+		TArray<TSharedPtr<FJsonValue>> AssetValues;
+		for (const FString& Asset : Entry.Assets) AssetValues.Add(MakeShared<FJsonValueString>(Asset));
+
+		EntryObject->SetArrayField(TEXT("Assets"), AssetValues);
+		EntryValues.Add(MakeShared<FJsonValueObject>(EntryObject));
+
+		SeverityCounts.FindOrAdd(GetSeverityName(Entry.Severity)) += Entry.Count;
+	}
+
+	const TSharedPtr<FJsonObject> Summary = MakeShared<FJsonObject>();
+	for (const TPair<FString, int32>& Count : SeverityCounts) Summary->SetNumberField(Count.Key, Count.Value);
+
+	const TSharedPtr<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Time"), FDateTime::Now().ToIso8601());
+	Report->SetObjectField(TEXT("Summary"), Summary);
+	Report->SetArrayField(TEXT("Entries"), EntryValues);
+
+	FString Content;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Content);
+	FJsonSerializer::Serialize(Report.ToSharedRef(), Writer);
+
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonAsAsset"), TEXT("ImportReport.json"));
+
+	if (!FFileHelper::SaveStringToFile(Content, *ReportPath)) {
+		UE_LOG(LogJson, Warning, TEXT("Failed to write import report to %s"), *ReportPath);
+	}
+}
+
+void FImportDiagnostics::ShowSummary() const {
+	if (IsRunningCommandlet() || !FSlateApplication::IsInitialized()) return;
+
+	int32 Imported = 0, Warnings = 0, Errors = 0;
+
+	for (const FEntry& Entry : Entries) {
+		if (Entry.Severity == EMessageSeverity::Error) Errors += Entry.Count;
+		else if (Entry.Severity == EMessageSeverity::Info) {
+			if (Entry.Category == EImportDiagnosticCategory::Imported || Entry.Category == EImportDiagnosticCategory::Patched) Imported += Entry.Count;
+		} else Warnings += Entry.Count;
+	}
+
+	FNotificationInfo Info = FNotificationInfo(FText::FromString(FString::Printf(TEXT("Imported %d asset(s)"), Imported)));
+	Info.ExpireDuration = Errors + Warnings > 0 ? 8.0f : 3.0f;
+	Info.bUseLargeFont = true;
+	Info.bUseSuccessFailIcons = true;
+	Info.WidthOverride = FOptionalSize(350);
+	Info.SubText = FText::FromString(FString::Printf(TEXT("%d warning(s), %d error(s), see the message log"), Warnings, Errors));
+
+	if (const TSharedPtr<SNotificationItem> NotificationPtr = FSlateNotificationManager::Get().AddNotification(Info)) {
+		NotificationPtr->SetCompletionState(Errors > 0 ? SNotificationItem::CS_Fail : SNotificationItem::CS_Success);
+	}
+}
@@ -0,0 +1,311 @@
+// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/ImportSession.h"
+#include "UObject/CoreRedirects.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/SavePackage.h"
+#include "Algo/StableSort.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "MaterialShared.h"
+#include "Settings/JsonAsAssetSettings.h"
+#include "Materials/MaterialExpression.h"
+#include "Utilities/ImportDiagnostics.h"
+
+FImportSession& FImportSession::Get() {
+	static FImportSession Session;
+	return Session;
+}
+
+bool FImportSession::FindReference(const FString& Key, UObject*& OutObject) const {
+	if (!IsActive()) return false;
+
+	const FCachedReference* Reference = References.Find(Key);
+	if (Reference == nullptr) return false;
+
+	// Object was garbage collected since, resolve it again
+	if (Reference->bFound && !Reference->Object.IsValid()) return false;
+
+	OutObject = Reference->Object.Get();
+	return true;
+}
+
+void FImportSession::AddReference(const FString& Key, UObject* Object) {
+	if (!IsActive()) return;
+
+	FCachedReference& Reference = References.FindOrAdd(Key);
+	Reference.Object = Object;
+	Reference.bFound = Object != nullptr;
+}
+
+void FImportSession::ForgetReference(const FString& ObjectPath) {
+	References.Remove(ObjectPath);
+}
+
+const FObjectFingerprint* FImportSession::FindObjectFingerprint(UObject* Object) const {
+	return ObjectFingerprints.Find(Object);
+}
+
+void FImportSession::SetObjectFingerprint(UObject* Object, const FObjectFingerprint& Fingerprint) {
+	ObjectFingerprints.Add(Object, Fingerprint);
+}
+
+UObject* FImportSession::FindCanonicalGraph(const FString& GraphHash) const {
+	const TWeakObjectPtr<UObject>* Asset = CanonicalGraphs.Find(GraphHash);
+
+	return Asset != nullptr ? Asset->Get() : nullptr;
+}
+
+void FImportSession::AddCanonicalGraph(const FString& GraphHash, UObject* Asset) {
+	if (!IsActive() || FindCanonicalGraph(GraphHash) != nullptr) return;
+
+	CanonicalGraphs.Add(GraphHash, Asset);
+}
+
+UClass* FImportSession::FindClass(const FString& ClassName) {
+	if (ClassName.IsEmpty()) return nullptr;
+
+	// Full paths don't need the table
+	if (ClassName.StartsWith(TEXT("/"))) {
+		if (UClass* Class = FindObject<UClass>(nullptr, *ClassName)) return Class;
+
+		return FindRedirectedClass(FName(*ClassName));
+	}
+
+	if (!bClassTableBuilt) BuildClassTable();
+
+	const FName Name(*ClassName);
+	if (UClass* const* Class = Classes.Find(Name)) return *Class;
+
+	UClass* Class = FindRedirectedClass(Name);
+
+	// Not native, may be a loaded blueprint generated class
+	if (Class == nullptr) {
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 1
+		Class = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+#else
+		Class = FindObject<UClass>(ANY_PACKAGE, *ClassName);
+#endif
+	}
+
+	// Negative results aren't cached, the class may be loaded later in the session.
+	// Neither are blueprint classes, those can be recompiled or unloaded while the table is alive
+	if (Class != nullptr && Class->HasAnyClassFlags(CLASS_Native)) Classes.Add(Name, Class);
+
+	return Class;
+}
+
+UClass* FImportSession::FindExpressionClass(const FString& ExpressionType) {
+	const FName Type(*ExpressionType);
+	if (UClass* const* Class = ExpressionClasses.Find(Type)) return *Class;
+
+	UClass* Class = FindClass(ExpressionType);
+
+	// Renamed when it moved into the Landscape module
+	if (!Class) Class = FindClass(ExpressionType.Replace(TEXT("MaterialExpressionPhysicalMaterialOutput"), TEXT("MaterialExpressionLandscapePhysicalMaterialOutput")));
+	if (Class && !Class->IsChildOf(UMaterialExpression::StaticClass())) Class = nullptr;
+
+	ExpressionClasses.Add(Type, Class);
+
+	return Class;
+}
+
+void FImportSession::BuildClassTable() {
+	const FName EnginePackageName = TEXT("/Script/Engine");
+	TSet<FName> PackageNames;
+
+	for (TObjectIterator<UClass> It; It; ++It) {
+		UClass* Class = *It;
+		if (!Class->HasAnyClassFlags(CLASS_Native) || Class->HasAnyClassFlags(CLASS_NewerVersionExists)) continue;
+
+		const FName PackageName = Class->GetOutermost()->GetFName();
+		PackageNames.Add(PackageName);
+
+		// On short name collisions, Engine classes win (these were the only ones resolved before)
+		UClass*& Entry = Classes.FindOrAdd(Class->GetFName());
+		if (Entry == nullptr || PackageName == EnginePackageName) {
+			Entry = Class;
+		}
+	}
+
+	ScriptPackageNames = PackageNames.Array();
+	bClassTableBuilt = true;
+}
+
+UClass* FImportSession::FindRedirectedClass(const FName ClassName) const {
+	const FCoreRedirectObjectName OldName(ClassName.ToString());
+
+	// Redirects without a package match the short name directly
+	FCoreRedirectObjectName NewName = FCoreRedirects::GetRedirectedName(ECoreRedirectFlags::Type_Class, OldName);
+	bool bRedirected = NewName != OldName;
+
+	// Otherwise try the name in every script package
+	if (!bRedirected && OldName.PackageName.IsNone()) {
+		for (const FName PackageName : ScriptPackageNames) {
+			const FCoreRedirectObjectName OldPackagedName(OldName.ObjectName, NAME_None, PackageName);
+			NewName = FCoreRedirects::GetRedirectedName(ECoreRedirectFlags::Type_Class, OldPackagedName);
+
+			if (NewName != OldPackagedName) {
+				bRedirected = true;
+				break;
+			}
+		}
+	}
+
+	if (!bRedirected) return nullptr;
+
+	return FindObject<UClass>(nullptr, *NewName.ToString());
+}
+
+UObject* FImportSession::FindArchetype(UClass* Class, UObject* Outer, const FName Name, const EObjectFlags Flags) {
+	// Names without a number are usually default subobjects, those have their own archetypes
+	if (Name.GetNumber() == NAME_NO_NUMBER_INTERNAL) {
+		return UObject::GetArchetypeFromRequiredInfo(Class, Outer, Name, Flags);
+	}
+
+	const FArchetypeKey Key { Class, Outer->GetArchetype(), FName(Name, NAME_NO_NUMBER_INTERNAL), Flags & (RF_ClassDefaultObject | RF_ArchetypeObject) };
+	if (const TWeakObjectPtr<UObject>* Archetype = Archetypes.Find(Key)) {
+		// The entry is shared by every number of the name, one of them can still be instanced on the outer's archetype
+		UObject* CachedArchetype = Archetype->Get();
+
+		if (CachedArchetype != nullptr && (Key.OuterArchetype == nullptr || StaticFindObjectFast(Class, Key.OuterArchetype, Name) == nullptr)) {
+			return CachedArchetype;
+		}
+	}
+
+	UObject* Archetype = UObject::GetArchetypeFromRequiredInfo(Class, Outer, Name, Flags);
+
+	if (Archetype == Class->GetDefaultObject(false)) {
+		Archetypes.Add(Key, Archetype);
+	}
+
+	return Archetype;
+}
+
+bool FImportSession::IsDeferringMaterialUpdates() const {
+	return IsActive() && (ForcedDeferralDepth > 0 || GetDefault<UJsonAsAssetSettings>()->AssetSettings.MaterialImportSettings.bDeferMaterialCompilation);
+}
+
+void FImportSession::DeferMaterialUpdate(UMaterialInterface* Material) {
+	if (UMaterial* BaseMaterial = Cast<UMaterial>(Material)) DeferredMaterials.Add(BaseMaterial);
+	else if (UMaterialInstanceConstant* Instance = Cast<UMaterialInstanceConstant>(Material)) DeferredInstances.Add(Instance);
+}
+
+void FImportSession::DeferStaticPermutationUpdate(UMaterialInstanceConstant* Instance, const FStaticParameterSet& StaticParameters) {
+	DeferredInstances.Add(Instance);
+	DeferredStaticParameters.Add(Instance, StaticParameters);
+}
+
+void FImportSession::FlushMaterialUpdates() {
+	if (DeferredMaterials.Num() == 0 && DeferredInstances.Num() == 0) return;
+
+	TSet<UPackage*> Packages;
+
+	{
+		FMaterialUpdateContext UpdateContext;
+
+		for (const TWeakObjectPtr<UMaterial>& WeakMaterial : DeferredMaterials) {
+			UMaterial* Material = WeakMaterial.Get();
+			if (Material == nullptr) continue;
+
+			// PostEditChange was skipped on import, it also recompiles the material
+			UpdateContext.AddMaterial(Material);
+			Material->PostEditChange();
+
+			Packages.Add(Material->GetOutermost());
+		}
+
+		// Instances of instances are compiled after their parents
+		auto GetDepth = [](const UMaterialInstance* Instance) {
+			int32 Depth = 0;
+
+			// Parent loops are reported on import but can still be here, stop once an instance repeats
+			TSet<const UMaterialInstance*> Visited = { Instance };
+
+			for (const UMaterialInstance* Parent = Cast<UMaterialInstance>(Instance->Parent); Parent; Parent = Cast<UMaterialInstance>(Parent->Parent)) {
+				bool bAlreadyVisited = false;
+				Visited.Add(Parent, &bAlreadyVisited);
+
+				if (bAlreadyVisited) break;
+				Depth++;
+			}
+
+			return Depth;
+		};
+
+		TArray<UMaterialInstanceConstant*> Instances;
+
+		for (const TWeakObjectPtr<UMaterialInstanceConstant>& WeakInstance : DeferredInstances) {
+			if (UMaterialInstanceConstant* Instance = WeakInstance.Get()) Instances.Add(Instance);
+		}
+
+		Algo::StableSortBy(Instances, GetDepth);
+
+		for (UMaterialInstanceConstant* Instance : Instances) {
+			UpdateContext.AddMaterialInstance(Instance);
+
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION >= 2
+			if (const FStaticParameterSet* StaticParameters = DeferredStaticParameters.Find(Instance)) {
+				Instance->UpdateStaticPermutation(*StaticParameters, &UpdateContext);
+			}
+#endif
+
+			// Below 5.2 this is what applies static switches written to the editor only data
+			Instance->PostEditChange();
+
+			Packages.Add(Instance->GetOutermost());
+		}
+	}
+
+	DeferredMaterials.Empty();
+	DeferredInstances.Empty();
+	DeferredStaticParameters.Empty();
+
+	// Importers skip saving deferred materials, they are saved once here
+	if (GetDefault<UJsonAsAssetSettings>()->AssetSettings.bSavePackagesOnImport) {
+		FSavePackageArgs SaveArgs; {
+			SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+			SaveArgs.Error = GError;
+			SaveArgs.SaveFlags = SAVE_NoError;
+		}
+
+		for (UPackage* Package : Packages) {
+			UPackage::SavePackage(Package, nullptr, *FPackageName::LongPackageNameToFilename(Package->GetName(), FPackageName::GetAssetPackageExtension()), SaveArgs);
+		}
+	}
+}
+
+void FImportSession::Reset() {
+	References.Empty();
+	Archetypes.Empty();
+	CanonicalGraphs.Empty();
+
+	// Fingerprints outlive the session, only drop the ones of collected objects
+	for (auto It = ObjectFingerprints.CreateIterator(); It; ++It) {
+		if (!It->Key.IsValid()) It.RemoveCurrent();
+	}
+
+	Classes.Empty();
+	ExpressionClasses.Empty();
+	ScriptPackageNames.Empty();
+	bClassTableBuilt = false;
+}
+
+FScopedImportSession::FScopedImportSession() {
+	FImportSession& Session = FImportSession::Get();
+
+	// Lookups made outside of a session may have filled the tables since the last one ended
+	if (Session.ScopeDepth++ == 0) {
+		Session.Reset();
+	}
+}
+
+FScopedImportSession::~FScopedImportSession() {
+	FImportSession& Session = FImportSession::Get();
+
+	if (--Session.ScopeDepth == 0) {
+		Session.FlushMaterialUpdates();
+		FImportDiagnostics::Get().Flush();
+		Session.Reset();
+	}
+}
@@ -2,7 +2,9 @@
 
 #include "Utilities/ObjectUtilities.h"
 #include "Utilities/PropertyUtilities.h"
+#include "Utilities/ImportSession.h"
 #include "UObject/Package.h"
+#include "Hash/CityHash.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogObjectSerializer, All, All);
 PRAGMA_DISABLE_OPTIMIZATION
@@ -27,12 +29,10 @@ void FObjectCompareContext::SetObjectSettings(int32 ObjectIndex, const FObjectCo
 }
 
 bool FObjectCompareContext::HasObjectAlreadyBeenCompared(int32 ObjectIndex, UObject* Object) {
-	const auto ObjectPair = TPair<int32, UObject*>(ObjectIndex, Object);
-	if (ObjectsAlreadyCompared.Contains(ObjectPair)) {
-		return true;
-	}
-	ObjectsAlreadyCompared.Add(ObjectPair);
-	return false;
+	bool bAlreadyCompared = false;
+	ObjectsAlreadyCompared.Add(TPair<int32, UObject*>(ObjectIndex, Object), &bAlreadyCompared);
+
+	return bAlreadyCompared;
 }
 
 FObjectCompareSettings FObjectCompareContext::GetObjectSettings(int32 ObjectIndex) const {
@@ -45,8 +45,57 @@ FObjectCompareSettings FObjectCompareContext::GetObjectSettings(int32 ObjectInde
 
 // ----------------------------------------
 
+static uint64 HashCombine64(const uint64 A, const uint64 B) {
+	return CityHash128to64(Uint128_64(A, B));
+}
+
+uint64 FJsonHash::Hash(const FJsonValue& Value) {
+	switch (Value.Type) {
+		case EJson::String: {
+			const FString String = Value.AsString();
+			return HashCombine64(static_cast<uint64>(EJson::String), CityHash64(reinterpret_cast<const char*>(*String), String.Len() * sizeof(TCHAR)));
+		}
+		case EJson::Number: {
+			const double Number = Value.AsNumber();
+			return HashCombine64(static_cast<uint64>(EJson::Number), CityHash64(reinterpret_cast<const char*>(&Number), sizeof(Number)));
+		}
+		case EJson::Boolean:
+			return HashCombine64(static_cast<uint64>(EJson::Boolean), Value.AsBool() ? 1 : 0);
+		case EJson::Array: {
+			uint64 ArrayHash = static_cast<uint64>(EJson::Array);
+
+			for (const TSharedPtr<FJsonValue>& Element : Value.AsArray()) {
+				ArrayHash = HashCombine64(ArrayHash, Element.IsValid() ? Hash(*Element) : 0);
+			}
+
+			return ArrayHash;
+		}
+		case EJson::Object:
+			return Hash(*Value.AsObject());
+		default:
+			return static_cast<uint64>(Value.Type);
+	}
+}
+
+uint64 FJsonHash::Hash(const FJsonObject& Object) {
+	// Field hashes are summed, so the order fields were written in doesn't matter
+	uint64 FieldsHash = 0;
+
+	for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Object.Values) {
+		const uint64 KeyHash = CityHash64(reinterpret_cast<const char*>(*Field.Key), Field.Key.Len() * sizeof(TCHAR));
+		FieldsHash += HashCombine64(KeyHash, Field.Value.IsValid() ? Hash(*Field.Value) : 0);
+	}
+
+	return HashCombine64(static_cast<uint64>(EJson::Object), FieldsHash);
+}
+
+// ----------------------------------------
+
 UObjectSerializer::UObjectSerializer() {
 	this->LastObjectIndex = 0;
+	this->ExportDepth = 0;
+	this->bDeferPendingProperties = false;
+	this->bStreamingSerialization = false;
 }
 
 UPackage* FindOrLoadPackage(const FString& PackageName) {
@@ -67,8 +116,42 @@ void UObjectSerializer::SetPropertySerializer(UPropertySerializer* NewPropertySe
 void UObjectSerializer::InitializeForDeserialization(const TArray<TSharedPtr<FJsonValue>>& ObjectsArray) {
 	this->LastObjectIndex = ObjectsArray.Num();
 
+	SerializedObjects.Reset(LastObjectIndex);
 	for (int32 i = 0; i < LastObjectIndex; i++) {
-		SerializedObjects.Add(i, ObjectsArray[i]->AsObject());
+		SerializedObjects.Add(ObjectsArray[i]->AsObject());
+	}
+
+	LoadedObjects.Init(nullptr, LastObjectIndex);
+	LoadedObjectIndices.Reset();
+	LoadedObjectFlags.Init(false, LastObjectIndex);
+
+	PendingPropertyFlags.Init(false, LastObjectIndex);
+	PendingPropertyObjects.Reset();
+	SiblingExports.Reset();
+
+	// Group exports by outer and class, imports are only ever found
+	for (int32 i = 0; i < LastObjectIndex; i++) {
+		const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects[i];
+
+		int32 OuterObjectIndex;
+		int32 ObjectClassIndex;
+		if (ObjectJson.IsValid() && ObjectJson->GetStringField(TEXT("Type")) == TEXT("Export") &&
+			ObjectJson->TryGetNumberField(TEXT("Outer"), OuterObjectIndex) && ObjectJson->TryGetNumberField(TEXT("ObjectClass"), ObjectClassIndex)) {
+			SiblingExports.FindOrAdd(TPair<int32, int32>(OuterObjectIndex, ObjectClassIndex)).Add(i);
+		}
+	}
+}
+
+void UObjectSerializer::SetLoadedObject(const int32 Index, UObject* Object) {
+	if (LoadedObjectFlags[Index] && LoadedObjects[Index] != nullptr) {
+		LoadedObjectIndices.RemoveSingle(LoadedObjects[Index], Index);
+	}
+
+	LoadedObjects[Index] = Object;
+	LoadedObjectFlags[Index] = true;
+
+	if (Object != nullptr) {
+		LoadedObjectIndices.AddUnique(Object, Index);
 	}
 }
 
@@ -83,27 +166,31 @@ void UObjectSerializer::SetPackageForDeserialization(UPackage* SelfPackage) {
 }
 
 void UObjectSerializer::SetObjectMark(UObject* Object, const FString& ObjectMark) {
-	UObject* const* OldMarkObjectValue = ObjectMarks.FindKey(ObjectMark);
+	UObject* const* OldMarkObjectValue = MarkedObjects.Find(ObjectMark);
+	UObject* OldMarkObject = OldMarkObjectValue != NULL ? *OldMarkObjectValue : NULL;
 
 	// If we have an old value for this mark and it's the same object, exit early
-	if (OldMarkObjectValue != NULL && *OldMarkObjectValue == Object) {
+	if (OldMarkObject == Object) {
 		return;
 	}
 
+	// An object only has one mark, drop the reverse entry of its previous one
+	if (const FString* PreviousMark = ObjectMarks.Find(Object)) {
+		this->MarkedObjects.Remove(*PreviousMark);
+	}
+
 	this->ObjectMarks.Add(Object, ObjectMark);
+	this->MarkedObjects.Add(ObjectMark, Object);
 
 	// If we have an old mapping, remove it immediately and try to remap old objects to new ones
-	if (OldMarkObjectValue != NULL) {
-		this->ObjectMarks.Remove(*OldMarkObjectValue);
+	if (OldMarkObject != NULL) {
+		this->ObjectMarks.Remove(OldMarkObject);
 
 		TArray<int32> IndicesToOverwrite;
-		for (const TPair<int32, UObject*>& Pair : this->LoadedObjects) {
-			if (Pair.Value == *OldMarkObjectValue) {
-				IndicesToOverwrite.Add(Pair.Key);
-			}
-		}
+		this->LoadedObjectIndices.MultiFind(OldMarkObject, IndicesToOverwrite);
+
 		for (const int32 ObjectIndex : IndicesToOverwrite) {
-			this->LoadedObjects.Add(ObjectIndex, Object);
+			SetLoadedObject(ObjectIndex, Object);
 		}
 	}
 }
@@ -118,11 +205,21 @@ int32 UObjectSerializer::SerializeObject(UObject* Object) {
 
 	const int32 NewObjectIndex = LastObjectIndex++;
 	ObjectIndices.Add(Object, NewObjectIndex);
+
+	// Streamed objects are written once every object before them is
+	if (bStreamingSerialization) {
+		StreamedObjects.Add(Object);
+		return NewObjectIndex;
+	}
+
 	UPackage* ObjectPackage = Object->GetOutermost();
 
 	TSharedRef<FJsonObject> ResultJson = MakeShareable(new FJsonObject());
 	ResultJson->SetNumberField(TEXT("ObjectIndex"), NewObjectIndex);
-	SerializedObjects.Add(NewObjectIndex, ResultJson);
+
+	// Indices are handed out in order, so the new object always lands at the end
+	check(SerializedObjects.Num() == NewObjectIndex);
+	SerializedObjects.Add(ResultJson);
 
 	if (ObjectPackage != SourcePackage) {
 		ResultJson->SetStringField(TEXT("Type"), TEXT("Import"));
@@ -130,9 +227,9 @@ int32 UObjectSerializer::SerializeObject(UObject* Object) {
 	} else {
 		ResultJson->SetStringField(TEXT("Type"), TEXT("Export"));
 
-		if (ObjectMarks.Contains(Object)) {
+		if (const FString* ObjectMark = ObjectMarks.Find(Object)) {
 			// This object is serialized using object mark string
-			ResultJson->SetStringField(TEXT("ObjectMark"), ObjectMarks.FindChecked(Object));
+			ResultJson->SetStringField(TEXT("ObjectMark"), *ObjectMark);
 		} else {
 			//Serialize object normally
 			SerializeExportedObject(ResultJson, Object);
@@ -146,24 +243,25 @@ UObject* UObjectSerializer::DeserializeObject(int32 Index) {
 	if (Index == INDEX_NONE)
 		return nullptr;
 
-	if (Index == 1)
-		Index = 0;
-	UObject** LoadedObject = LoadedObjects.Find(Index);
-	if (LoadedObject != nullptr)
-		return *LoadedObject;
+	if (IsObjectLoaded(Index)) {
+		if (!bDeferPendingProperties && PendingPropertyFlags.IsValidIndex(Index) && PendingPropertyFlags[Index])
+			DeserializePendingProperties(Index);
 
-	if (!SerializedObjects.Contains(Index)) {
+		return LoadedObjects[Index];
+	}
+
+	if (!IsValidObjectIndex(Index)) {
 		UE_LOG(LogObjectSerializer, Error, TEXT("DeserializeObject for package %s called with invalid Index: %d"), *SourcePackage->GetName(), Index);
 		return nullptr;
 	}
 
-	const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects.FindChecked(Index);
-	FString ObjectType = Index == 0 ? "Import" : "Export";
+	const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects[Index];
+	const FString ObjectType = ObjectJson->GetStringField(TEXT("Type"));
 
 	if (ObjectType == TEXT("Import")) {
 		// Object is imported from another package, and not located in our own
 		UObject* NewLoadedObject = DeserializeImportedObject(ObjectJson);
-		LoadedObjects.Add(Index, NewLoadedObject);
+		SetLoadedObject(Index, NewLoadedObject);
 
 		return NewLoadedObject;
 	}
@@ -175,7 +273,7 @@ UObject* UObjectSerializer::DeserializeObject(int32 Index) {
 		if (ObjectJson->HasField(TEXT("ObjectMark"))) {
 			// Object is serialized through object mark
 			const FString ObjectMark = ObjectJson->GetStringField(TEXT("ObjectMark"));
-			UObject* const* FoundObject = ObjectMarks.FindKey(ObjectMark);
+			UObject* const* FoundObject = MarkedObjects.Find(ObjectMark);
 			checkf(FoundObject, TEXT("Cannot resolve object serialized using mark: %s"), *ObjectMark);
 			ConstructedObject = *FoundObject;
 		} else {
@@ -183,7 +281,7 @@ UObject* UObjectSerializer::DeserializeObject(int32 Index) {
 			ConstructedObject = DeserializeExportedObject(Index, ObjectJson);
 		}
 
-		LoadedObjects.Add(Index, ConstructedObject);
+		SetLoadedObject(Index, ConstructedObject);
 		return ConstructedObject;
 	}
 
@@ -191,6 +289,68 @@ UObject* UObjectSerializer::DeserializeObject(int32 Index) {
 	return nullptr;
 }
 
+void UObjectSerializer::DeserializeAllExports() {
+	// Order exports so every outer comes before the objects inside of it
+	TArray<int32> ConstructionOrder;
+	ConstructionOrder.Reserve(LastObjectIndex);
+
+	TBitArray<> Ordered(false, LastObjectIndex);
+	TArray<int32> OuterChain;
+
+	for (int32 i = 0; i < LastObjectIndex; i++) {
+		// Walk up the outer chain until an outer that is already ordered (or an import)
+		int32 Index = i;
+		while (IsValidObjectIndex(Index) && !Ordered[Index] && SerializedObjects[Index]->GetStringField(TEXT("Type")) == TEXT("Export")) {
+			Ordered[Index] = true;
+			OuterChain.Add(Index);
+
+			int32 OuterObjectIndex;
+			Index = SerializedObjects[Index]->TryGetNumberField(TEXT("Outer"), OuterObjectIndex) ? OuterObjectIndex : INDEX_NONE;
+		}
+
+		while (OuterChain.Num() > 0) {
+			ConstructionOrder.Add(OuterChain.Pop());
+		}
+	}
+
+	bDeferPendingProperties = true;
+
+	// Phase one: allocate every export
+	for (const int32 Index : ConstructionOrder) {
+		if (IsObjectLoaded(Index))
+			continue;
+
+		const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects[Index];
+
+		// Marked and root objects aren't constructed, resolve them normally
+		if (ObjectJson->HasField(TEXT("ObjectMark")) || !ObjectJson->HasField(TEXT("Outer"))) {
+			DeserializeObject(Index);
+			continue;
+		}
+
+		UClass* ObjectClass = Cast<UClass>(DeserializeObject(ObjectJson->GetIntegerField(TEXT("ObjectClass"))));
+		UObject* OuterObject = DeserializeObject(ObjectJson->GetIntegerField(TEXT("Outer")));
+
+		if (ObjectClass == nullptr || OuterObject == nullptr) {
+			UE_LOG(LogObjectSerializer, Error, TEXT("DeserializeAllExports for package %s failed: Cannot resolve class or outer of object %d"), *SourcePackage->GetName(), Index);
+			SetLoadedObject(Index, nullptr);
+
+			continue;
+		}
+
+		SetLoadedObject(Index, ConstructExportedObject(ObjectClass, OuterObject, ObjectJson));
+		PendingPropertyFlags[Index] = true;
+	}
+
+	// Phase two: fill properties, references to exports are table lookups now
+	for (const int32 Index : ConstructionOrder) {
+		if (PendingPropertyFlags[Index])
+			DeserializePendingProperties(Index);
+	}
+
+	bDeferPendingProperties = false;
+}
+
 TSharedRef<FJsonObject> UObjectSerializer::SerializeObjectProperties(UObject* Object) {
 	TSharedRef<FJsonObject> Properties = MakeShareable(new FJsonObject());
 	SerializeObjectPropertiesIntoObject(Object, Properties);
@@ -233,7 +393,7 @@ bool UObjectSerializer::CompareObjectsWithContext(const int32 ObjectIndex, UObje
 			return false;
 
 		// If the object is not found, deserializing it would still be NULL
-		const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects.FindChecked(ObjectIndex);
+		const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects[ObjectIndex];
 		const FString ObjectType = ObjectJson->GetStringField(TEXT("Type"));
 
 		return ObjectType == TEXT("Import") && DeserializeObject(ObjectIndex) == NULL;
@@ -244,7 +404,7 @@ bool UObjectSerializer::CompareObjectsWithContext(const int32 ObjectIndex, UObje
 	if (CompareContext->HasObjectAlreadyBeenCompared(ObjectIndex, Object))
 		return true;
 
-	const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects.FindChecked(ObjectIndex);
+	const TSharedPtr<FJsonObject>& ObjectJson = SerializedObjects[ObjectIndex];
 	const FString ObjectType = ObjectJson->GetStringField(TEXT("Type"));
 	const FObjectCompareSettings CompareSettings = CompareContext->GetObjectSettings(ObjectIndex);
 
@@ -269,7 +429,7 @@ bool UObjectSerializer::CompareObjectsWithContext(const int32 ObjectIndex, UObje
 	// Check if object is serialized through mark first
 	if (ObjectJson->HasField(TEXT("ObjectMark"))) {
 		const FString ObjectMark = ObjectJson->GetStringField(TEXT("ObjectMark"));
-		UObject* const* FoundObject = ObjectMarks.FindKey(ObjectMark);
+		UObject* const* FoundObject = MarkedObjects.Find(ObjectMark);
 
 		checkf(FoundObject, TEXT("Cannot resolve object serialized using mark: %s"), *ObjectMark);
 		UObject* RegisteredObject = *FoundObject;
@@ -312,6 +472,12 @@ bool UObjectSerializer::CompareObjectsWithContext(const int32 ObjectIndex, UObje
 bool UObjectSerializer::AreObjectPropertiesUpToDate(const TSharedPtr<FJsonObject>& Properties, UObject* Object, const TSharedPtr<FObjectCompareContext> Context) {
 	UClass* ObjectClass = Object->GetClass();
 
+	// Referenced objects are compared by contents here, so those still need the deep compare
+	const EFingerprintMatch FingerprintMatch = MatchObjectFingerprint(*Properties, Object);
+
+	if (FingerprintMatch == EFingerprintMatch::OutOfDate) return false;
+	if (FingerprintMatch == EFingerprintMatch::UpToDate && !FImportSession::Get().FindObjectFingerprint(Object)->bReferencesObjects) return true;
+
 	// Iterate all properties and return false if our values do not match existing ones
 	// 
 	// This will also try to deserialize objects in "read only" mode, incrementing 
@@ -329,18 +495,59 @@ bool UObjectSerializer::AreObjectPropertiesUpToDate(const TSharedPtr<FJsonObject
 		}
 	}
 
+	RecordObjectFingerprint(*Properties, Object);
+
 	return true;
 }
 
+uint32 UObjectSerializer::HashObjectProperties(UObject* Object, bool& bOutReferencesObjects) const {
+	uint32 Hash = GetTypeHash(Object->GetClass());
+
+	for (FProperty* Property = Object->GetClass()->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		if (PropertySerializer->ShouldSerializeProperty(Property)) {
+			Hash = HashCombine(Hash, PropertySerializer->HashPropertyValue(Property, Property->ContainerPtrToValuePtr<void>(Object), bOutReferencesObjects));
+		}
+	}
+
+	return Hash;
+}
+
+void UObjectSerializer::RecordObjectFingerprint(const FJsonObject& Properties, UObject* Object) const {
+	FObjectFingerprint Fingerprint;
+
+	Fingerprint.JsonHash = FJsonHash::Hash(Properties);
+	Fingerprint.MemoryHash = HashObjectProperties(Object, Fingerprint.bReferencesObjects);
+
+	FImportSession::Get().SetObjectFingerprint(Object, Fingerprint);
+}
+
+UObjectSerializer::EFingerprintMatch UObjectSerializer::MatchObjectFingerprint(const FJsonObject& Properties, UObject* Object) const {
+	const FObjectFingerprint* Fingerprint = FImportSession::Get().FindObjectFingerprint(Object);
+	if (Fingerprint == nullptr) return EFingerprintMatch::Unknown;
+
+	// The old JSON only says something about the object if it wasn't modified since
+	bool bReferencesObjects = false;
+	if (Fingerprint->MemoryHash != HashObjectProperties(Object, bReferencesObjects)) return EFingerprintMatch::Unknown;
+
+	return Fingerprint->JsonHash == FJsonHash::Hash(Properties) ? EFingerprintMatch::UpToDate : EFingerprintMatch::OutOfDate;
+}
+
 void UObjectSerializer::FlushPropertiesIntoObject(const int32 ObjectIndex, UObject* Object, const bool bVerifyNameAndRename, const bool bVerifyOuterAndMove) {
 	check(ObjectIndex != INDEX_NONE);
 	check(Object);
 
-	const TSharedPtr<FJsonObject> ObjectData = this->SerializedObjects.FindChecked(ObjectIndex);
+	const TSharedPtr<FJsonObject> ObjectData = this->SerializedObjects[ObjectIndex];
 	if (ObjectData->Values.Num() == 0) return; // If the object entry is empty, ignore
 
-	checkf(!this->LoadedObjects.Contains(ObjectIndex), TEXT("Cannot flush properties into already deserialized object"));
-	this->LoadedObjects.Add(ObjectIndex, Object);
+	// Siblings are constructed ahead of their properties, flushing into one of those is still allowed
+	const bool bPendingSibling = IsObjectLoaded(ObjectIndex) && PendingPropertyFlags[ObjectIndex] && LoadedObjects[ObjectIndex] == Object;
+	checkf(!IsObjectLoaded(ObjectIndex) || bPendingSibling, TEXT("Cannot flush properties into already deserialized object"));
+
+	if (bPendingSibling) {
+		PendingPropertyFlags[ObjectIndex] = false;
+	} else {
+		SetLoadedObject(ObjectIndex, Object);
+	}
 
 	const FString ObjectType = ObjectData->GetStringField(TEXT("Type"));
 	checkf(ObjectType == TEXT("Export"), TEXT("Can only call FlushPropertiesIntoObject for exported objects"));
@@ -383,75 +590,160 @@ void UObjectSerializer::DeserializeObjectProperties(const TSharedPtr<FJsonObject
 	}
 }
 
+TArray<FString> UObjectSerializer::ApplyPropertyPatch(const TSharedPtr<FJsonObject>& Properties, UObject* Object) {
+	TArray<FString> ChangedPaths;
+
+	// Re-importing the same file over an untouched asset, references are patched by path so their contents don't matter
+	if (MatchObjectFingerprint(*Properties, Object) == EFingerprintMatch::UpToDate) {
+		return ChangedPaths;
+	}
+
+	for (FProperty* Property = Object->GetClass()->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		const TSharedPtr<FJsonValue>* ValueObject = Properties->Values.Find(Property->GetName());
+
+		if (ValueObject != nullptr && ValueObject->IsValid() && PropertySerializer->ShouldSerializeProperty(Property)) {
+			void* PropertyValue = Property->ContainerPtrToValuePtr<void>(Object);
+			PatchPropertyValue(Object, Property, Property, PropertyValue, ValueObject->ToSharedRef(), Property->GetName(), ChangedPaths);
+		}
+	}
+
+	RecordObjectFingerprint(*Properties, Object);
+
+	return ChangedPaths;
+}
+
+void UObjectSerializer::PatchPropertyValue(UObject* Object, FProperty* MemberProperty, FProperty* Property, void* Value, const TSharedRef<FJsonValue>& JsonValue, const FString& PropertyPath, TArray<FString>& OutChangedPaths) {
+	if (PropertySerializer->ComparePropertyValues(Property, JsonValue, Value))
+		return;
+
+	// Reflected structs are diffed member by member, so only the members that changed are written
+	const FStructProperty* StructProperty = CastField<const FStructProperty>(Property);
+
+	if (StructProperty && Property->ArrayDim == 1 && JsonValue->Type == EJson::Object &&
+		PropertySerializer->GetStructSerializer(StructProperty->Struct) == PropertySerializer->FallbackStructSerializer.Get()) {
+		const TSharedPtr<FJsonObject> StructJson = JsonValue->AsObject();
+
+		for (FProperty* StructMember = StructProperty->Struct->PropertyLink; StructMember; StructMember = StructMember->PropertyLinkNext) {
+			const TSharedPtr<FJsonValue>* MemberValue = StructJson->Values.Find(StructMember->GetName());
+
+			if (MemberValue != nullptr && MemberValue->IsValid() && PropertySerializer->ShouldSerializeProperty(StructMember)) {
+				void* MemberValuePtr = StructMember->ContainerPtrToValuePtr<void>(Value);
+				PatchPropertyValue(Object, MemberProperty, StructMember, MemberValuePtr, MemberValue->ToSharedRef(), PropertyPath + TEXT(".") + StructMember->GetName(), OutChangedPaths);
+			}
+		}
+
+		return;
+	}
+
+	Object->PreEditChange(MemberProperty);
+	PropertySerializer->DeserializePropertyValue(Property, JsonValue, Value);
+
+	FPropertyChangedEvent ChangedEvent(Property, EPropertyChangeType::ValueSet);
+	ChangedEvent.SetActiveMemberProperty(MemberProperty);
+	Object->PostEditChangeProperty(ChangedEvent);
+
+	OutChangedPaths.Add(PropertyPath);
+}
+
 TArray<TSharedPtr<FJsonValue>> UObjectSerializer::FinalizeSerialization() {
 	TArray<TSharedPtr<FJsonValue>> ObjectsArray;
+	ObjectsArray.Reserve(LastObjectIndex);
 
-	for (int32 i = 0; i < LastObjectIndex; i++) {
-		if (!SerializedObjects.Contains(i)) {
-			checkf(false, TEXT("Object not in serialized objects: %s"), *(*ObjectIndices.FindKey(i))->GetPathName());
-		}
-		
-		ObjectsArray.Add(MakeShareable(new FJsonValueObject(SerializedObjects.FindChecked(i))));
+	checkf(SerializedObjects.Num() == LastObjectIndex, TEXT("Serialized objects are out of sync with object indices"));
+
+	for (const TSharedPtr<FJsonObject>& SerializedObject : SerializedObjects) {
+		ObjectsArray.Add(MakeShareable(new FJsonValueObject(SerializedObject)));
 	}
 	return ObjectsArray;
 }
 
 void UObjectSerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames) {
-	TArray<int32> AlreadySerializedObjects;
-	CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, AlreadySerializedObjects);
+	// Package names already in the output keep their place
+	FPackageCollectionState State;
+	State.PackageNames.Append(OutReferencedPackageNames);
+
+	CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, State);
 }
 
-void UObjectSerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized) {
-	for (const TSharedPtr<FJsonValue>& JsonValue : ReferencedSubobjects) {
-		CollectObjectPackages(JsonValue->AsNumber(), OutReferencedPackageNames, ObjectsAlreadySerialized);
+void UObjectSerializer::CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State) {
+	TArray<int32> ObjectStack;
+	ObjectStack.Reserve(ReferencedSubobjects.Num());
+
+	// Pushed in reverse, so objects are visited in the order they are referenced
+	for (int32 i = ReferencedSubobjects.Num() - 1; i >= 0; i--) {
+		ObjectStack.Add(ReferencedSubobjects[i]->AsNumber());
 	}
+
+	CollectPackages(ObjectStack, OutReferencedPackageNames, State);
 }
 
-void UObjectSerializer::CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized) {
-	if (ObjectIndex == INDEX_NONE)
-		return;
-	if (ObjectsAlreadySerialized.Contains(ObjectIndex))
-		return;
+void UObjectSerializer::CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State) {
+	TArray<int32> ObjectStack;
+	ObjectStack.Add(ObjectIndex);
 
-	ObjectsAlreadySerialized.Add(ObjectIndex);
-	const TSharedPtr<FJsonObject> Object = SerializedObjects.FindChecked(ObjectIndex);
-	const FString ObjectType = Object->GetStringField(TEXT("Type"));
+	CollectPackages(ObjectStack, OutReferencedPackageNames, State);
+}
 
-	if (ObjectType == TEXT("Import")) {
-		const FString ClassPackage = Object->GetStringField(TEXT("ClassPackage"));
-		if (!ClassPackage.StartsWith(TEXT("/Script/")))
-			OutReferencedPackageNames.AddUnique(ClassPackage);
+void UObjectSerializer::CollectPackages(TArray<int32>& ObjectStack, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State) {
+	TBitArray<>& VisitedObjects = State.VisitedObjects;
 
-		if (Object->HasField(TEXT("Outer"))) {
-			const int32 OuterObjectIndex = Object->GetIntegerField(TEXT("Outer"));
-			CollectObjectPackages(OuterObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
-		} else {
-			const FString PackageName = Object->GetStringField(TEXT("ObjectName"));
-			OutReferencedPackageNames.AddUnique(PackageName);
-		}
-	} else if (ObjectType == TEXT("Export")) {
-		if (Object->HasField(TEXT("ObjectMark")))
-			return;
+	if (VisitedObjects.Num() < SerializedObjects.Num()) {
+		VisitedObjects.Add(false, SerializedObjects.Num() - VisitedObjects.Num());
+	}
 
-		const int32 ObjectClassIndex = Object->GetIntegerField(TEXT("ObjectClass"));
-		CollectObjectPackages(ObjectClassIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
+	// New package names are appended once
+	const auto AddPackageName = [&State, &OutReferencedPackageNames](const FString& PackageName) {
+		bool bAlreadyAdded = false;
+		State.PackageNames.Add(PackageName, &bAlreadyAdded);
 
-		if (Object->HasField(TEXT("Outer"))) {
-			const int32 OuterObjectIndex = Object->GetIntegerField(TEXT("Outer"));
-			CollectObjectPackages(OuterObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
-		}
+		if (!bAlreadyAdded) OutReferencedPackageNames.Add(PackageName);
+	};
+
+	// Dependencies are pushed in reverse, so they are visited in the same order as a recursive walk would
+	while (ObjectStack.Num() > 0) {
+		const int32 ObjectIndex = ObjectStack.Pop();
 
-		if (Object->HasField(TEXT("Properties"))) {
-			const TSharedPtr<FJsonObject> Properties = Object->GetObjectField(TEXT("Properties"));
-			const TArray<TSharedPtr<FJsonValue>> ReferencedSubobjects = Properties->GetArrayField(TEXT("$ReferencedObjects"));
+		if (!IsValidObjectIndex(ObjectIndex) || VisitedObjects[ObjectIndex])
+			continue;
 
-			CollectReferencedPackages(ReferencedSubobjects, OutReferencedPackageNames, ObjectsAlreadySerialized);
+		VisitedObjects[ObjectIndex] = true;
+		const TSharedPtr<FJsonObject>& Object = SerializedObjects[ObjectIndex];
+		const FString ObjectType = Object->GetStringField(TEXT("Type"));
+
+		if (ObjectType == TEXT("Import")) {
+			const FString ClassPackage = Object->GetStringField(TEXT("ClassPackage"));
+			if (!ClassPackage.StartsWith(TEXT("/Script/")))
+				AddPackageName(ClassPackage);
+
+			if (Object->HasField(TEXT("Outer"))) {
+				ObjectStack.Add(Object->GetIntegerField(TEXT("Outer")));
+			} else {
+				AddPackageName(Object->GetStringField(TEXT("ObjectName")));
+			}
+		} else if (ObjectType == TEXT("Export")) {
+			if (Object->HasField(TEXT("ObjectMark")))
+				continue;
+
+			if (Object->HasField(TEXT("Properties"))) {
+				const TSharedPtr<FJsonObject> Properties = Object->GetObjectField(TEXT("Properties"));
+				const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects = Properties->GetArrayField(TEXT("$ReferencedObjects"));
+
+				for (int32 i = ReferencedSubobjects.Num() - 1; i >= 0; i--) {
+					ObjectStack.Add(ReferencedSubobjects[i]->AsNumber());
+				}
+			}
+
+			if (Object->HasField(TEXT("Outer"))) {
+				ObjectStack.Add(Object->GetIntegerField(TEXT("Outer")));
+			}
+
+			ObjectStack.Add(Object->GetIntegerField(TEXT("ObjectClass")));
 		}
 	}
 }
 
 FString UObjectSerializer::GetObjectFullPath(int32 ObjectIndex) {
-	const TSharedPtr<FJsonObject> Object = SerializedObjects.FindChecked(ObjectIndex);
+	const TSharedPtr<FJsonObject> Object = SerializedObjects[ObjectIndex];
 	const FString ObjectType = Object->GetStringField(TEXT("Type"));
 
 	if (ObjectType == TEXT("Import")) {
@@ -495,31 +787,18 @@ FString UObjectSerializer::GetObjectFullPath(int32 ObjectIndex) {
 	return TEXT("");
 }
 UObject* UObjectSerializer::DeserializeExportedObject(int32 ObjectIndex, TSharedPtr<FJsonObject> ObjectJson) {
-	// Object is defined inside our own package, so we should have
-	// NOTE: Probably shouldn't be a export
-	const FString ObjectClassIndex = ObjectJson->GetStringField(TEXT("Type"));
-	const FString PackageName = "/Script/Engine";
-
-	UPackage* ClassPackage = FindOrLoadPackage(PackageName);
-	UClass* ObjectClass = FindObjectFast<UClass>(ClassPackage, *ObjectClassIndex);
-
-	if (ObjectClass == nullptr) {
-		UE_LOG(LogObjectSerializer, Error, TEXT("DeserializeObject for package %s failed: Cannot resolve object class %s"), *SourcePackage->GetName(), *ObjectClassIndex);
-		return nullptr;
-	}
-
-	const FString ObjectName = ObjectJson->GetStringField(TEXT("Name"));
-	const FString PackageSpot = ObjectJson->GetStringField(TEXT("Package"));
-
 	// Outer will be missing for root UPackage export, e.g SourcePackage
 	if (!ObjectJson->HasField(TEXT("Outer"))) {
 		return SourcePackage;
 	}
-	
-	if (ObjectJson->HasField(TEXT("bIsPackaged"))) {
-		UPackage* ResultPackage = FindOrLoadPackage(PackageSpot);
 
-		return StaticFindObjectFast(ObjectClass, ResultPackage, *ObjectName);
+	// Object is defined inside our own package, so its class is an import (or an export for blueprint classes)
+	const int32 ObjectClassIndex = ObjectJson->GetIntegerField(TEXT("ObjectClass"));
+	UClass* ObjectClass = Cast<UClass>(DeserializeObject(ObjectClassIndex));
+
+	if (ObjectClass == nullptr) {
+		UE_LOG(LogObjectSerializer, Error, TEXT("DeserializeObject for package %s failed: Cannot resolve object class %d"), *SourcePackage->GetName(), ObjectClassIndex);
+		return nullptr;
 	}
 
 	const int32 OuterObjectIndex = ObjectJson->GetIntegerField(TEXT("Outer"));
@@ -531,75 +810,118 @@ UObject* UObjectSerializer::DeserializeExportedObject(int32 ObjectIndex, TShared
 		return nullptr;
 	}
 
-	UObject* ConstructedObject;
+	UObject* ConstructedObject = ConstructExportedObject(ObjectClass, OuterObject, ObjectJson);
+
+	// Record constructed object so when properties reference it through outer chain we do not run into stack overflow
+	SetLoadedObject(ObjectIndex, ConstructedObject);
+	ExportDepth++;
+
+	// Siblings of the same class share the outer and archetype, construct them together and fill their properties later
+	if (const TArray<int32>* Siblings = SiblingExports.Find(TPair<int32, int32>(OuterObjectIndex, ObjectClassIndex))) {
+		for (const int32 SiblingIndex : *Siblings) {
+			if (IsObjectLoaded(SiblingIndex))
+				continue;
+
+			const TSharedPtr<FJsonObject>& SiblingJson = SerializedObjects[SiblingIndex];
+			if (SiblingJson->HasField(TEXT("ObjectMark")))
+				continue;
+
+			SetLoadedObject(SiblingIndex, ConstructExportedObject(ObjectClass, OuterObject, SiblingJson));
+			PendingPropertyFlags[SiblingIndex] = true;
+			PendingPropertyObjects.Add(SiblingIndex);
+		}
+	}
+
+	// Deserialize object properties now
+	DeserializeExportedProperties(ObjectJson, ConstructedObject);
+
+	// Once the outermost export is done, fill siblings nothing referenced
+	if (ExportDepth == 1)
+		FlushPendingProperties();
+
+	ExportDepth--;
+	return ConstructedObject;
+}
+
+UObject* UObjectSerializer::ConstructExportedObject(UClass* ObjectClass, UObject* OuterObject, const TSharedPtr<FJsonObject>& ObjectJson) {
+	const FName ObjectName = *ObjectJson->GetStringField(TEXT("ObjectName"));
 
 	// Try to resolve existing object inside of the outer first
-	if (UObject* ExistingObject = StaticFindObjectFast(ObjectClass, OuterObject, *ObjectName)) {
-		ConstructedObject = ExistingObject;
-	} else {
-		// Construct new object if we cannot otherwise
-		const EObjectFlags ObjectLoadFlags = (EObjectFlags)ObjectJson->GetIntegerField(TEXT("ObjectFlags"));
-		UObject* Template = GetArchetypeFromRequiredInfo(ObjectClass, OuterObject, *ObjectName, ObjectLoadFlags);
+	if (UObject* ExistingObject = StaticFindObjectFast(ObjectClass, OuterObject, ObjectName)) {
+		return ExistingObject;
+	}
+
+	// Construct new object if we cannot otherwise
+	const EObjectFlags ObjectLoadFlags = (EObjectFlags)ObjectJson->GetIntegerField(TEXT("ObjectFlags"));
+	UObject* Template = FImportSession::Get().FindArchetype(ObjectClass, OuterObject, ObjectName, ObjectLoadFlags);
 
 #if ENGINE_MAJOR_VERSION == 5 && (ENGINE_MINOR_VERSION >= 4 || (ENGINE_MINOR_VERSION == 3 && ENGINE_PATCH_VERSION == 2)) // UE 5.4
-		FStaticConstructObjectParameters ConstructObjectParameters(ObjectClass);
-		ConstructObjectParameters.Outer = OuterObject;
-		ConstructObjectParameters.Name = *ObjectName;
-		ConstructObjectParameters.SetFlags = ObjectLoadFlags;
-		ConstructObjectParameters.InternalSetFlags = EInternalObjectFlags::None;
-		ConstructObjectParameters.Template = Template;
-		ConstructedObject = StaticConstructObject_Internal(ConstructObjectParameters);
+	FStaticConstructObjectParameters ConstructObjectParameters(ObjectClass);
+	ConstructObjectParameters.Outer = OuterObject;
+	ConstructObjectParameters.Name = ObjectName;
+	ConstructObjectParameters.SetFlags = ObjectLoadFlags;
+	ConstructObjectParameters.InternalSetFlags = EInternalObjectFlags::None;
+	ConstructObjectParameters.Template = Template;
+	return StaticConstructObject_Internal(ConstructObjectParameters);
 #else
-		ConstructedObject = StaticConstructObject_Internal(ObjectClass, OuterObject, *ObjectName, ObjectLoadFlags, EInternalObjectFlags::None, Template);
+	return StaticConstructObject_Internal(ObjectClass, OuterObject, ObjectName, ObjectLoadFlags, EInternalObjectFlags::None, Template);
 #endif
-	}
+}
 
-	// Record constructed object so when properties reference it through outer chain we do not run into stack overflow
-	LoadedObjects.Add(ObjectIndex, ConstructedObject);
+void UObjectSerializer::DeserializeExportedProperties(const TSharedPtr<FJsonObject>& ObjectJson, UObject* Object) {
+	if (Object == nullptr || !ObjectJson->HasField(TEXT("Properties")))
+		return;
 
-	// Deserialize object properties now
-	if (ObjectJson->HasField(TEXT("Properties"))) {
-		const TSharedPtr<FJsonObject>& Properties = ObjectJson->GetObjectField(TEXT("Properties"));
-		if (Properties.IsValid()) {
-			DeserializeObjectProperties(Properties.ToSharedRef(), ConstructedObject);
-		}
+	const TSharedPtr<FJsonObject>& Properties = ObjectJson->GetObjectField(TEXT("Properties"));
+	if (Properties.IsValid()) {
+		DeserializeObjectProperties(Properties.ToSharedRef(), Object);
 	}
+}
 
-	return ConstructedObject;
+void UObjectSerializer::DeserializePendingProperties(const int32 ObjectIndex) {
+	// Cleared first, properties may reference the object again
+	PendingPropertyFlags[ObjectIndex] = false;
+
+	DeserializeExportedProperties(SerializedObjects[ObjectIndex], LoadedObjects[ObjectIndex]);
+}
+
+void UObjectSerializer::FlushPendingProperties() {
+	while (PendingPropertyObjects.Num() > 0) {
+		const int32 ObjectIndex = PendingPropertyObjects.Pop();
+
+		if (PendingPropertyFlags[ObjectIndex])
+			DeserializePendingProperties(ObjectIndex);
+	}
 }
 
 UObject* UObjectSerializer::DeserializeImportedObject(TSharedPtr<FJsonObject> ObjectJson) {
-	const FString ObjectClassIndex = ObjectJson->GetStringField(TEXT("Type"));
-	const FString PackageName = "/Script/Engine";
-	UPackage* ClassPackage = FindOrLoadPackage(PackageName);
-	
+	const FString ClassPackage = ObjectJson->GetStringField(TEXT("ClassPackage"));
 	const FString ClassName = ObjectJson->GetStringField(TEXT("ClassName"));
-	const FString ObjectName = ObjectJson->GetStringField(TEXT("Name"));
-	
-	if (ClassPackage == NULL) {
-		UE_LOG(LogObjectSerializer, Error, TEXT("Failed to resolve class package %s"), *PackageName);
-		return NULL;
+	const FString ObjectName = ObjectJson->GetStringField(TEXT("ObjectName"));
+
+	// Outer is absent for root UPackage imports - Use ObjectName with LoadPackage directly
+	if (!ObjectJson->HasField(TEXT("Outer"))) {
+		return FindOrLoadPackage(ObjectName);
 	}
-	
-	UClass* ObjectClass = FindObjectFast<UClass>(ClassPackage, *ObjectClassIndex);
-	if (ObjectClass == NULL) {
-		UE_LOG(LogObjectSerializer, Error, TEXT("Failed to resolve class %s inside of the package %s (requested by %s)"), *ClassName, *PackageName, *SourcePackage->GetName());
-		return NULL;
+
+	// Classes are looked up by their full path first, native classes load with their module
+	if (!ClassPackage.StartsWith(TEXT("/Script/"))) {
+		FindOrLoadPackage(ClassPackage);
 	}
 
-	// Outer is absent for root UPackage imports - Use ObjectName with LoadPackage directly
-	if (ObjectJson->HasField(TEXT("bIsPackaged"))) {
-		UPackage* ResultPackage = FindOrLoadPackage(ObjectName);
-		if (ResultPackage == NULL)
-			return NULL;
+	UClass* ObjectClass = FindObject<UClass>(nullptr, *(ClassPackage + TEXT(".") + ClassName));
+	if (ObjectClass == NULL) {
+		ObjectClass = FImportSession::Get().FindClass(ClassName);
+	}
 
-		return ResultPackage;
+	if (ObjectClass == NULL) {
+		UE_LOG(LogObjectSerializer, Error, TEXT("Failed to resolve class %s.%s (requested by %s)"), *ClassPackage, *ClassName, *SourcePackage->GetName());
+		return NULL;
 	}
 
 	// Otherwise, it is a normal object inside some outer
-	// have to actually find the outer here.
-	int32 OuterObjectIndex = ObjectJson->GetIntegerField(TEXT("Outer"));
-	UObject* OuterObject = (OuterObjectIndex == ObjectJson->GetIntegerField(TEXT("Outer"))) ? FindOrLoadPackage("/Script/Engine") : DeserializeObject(OuterObjectIndex);
+	const int32 OuterObjectIndex = ObjectJson->GetIntegerField(TEXT("Outer"));
+	UObject* OuterObject = DeserializeObject(OuterObjectIndex);
 
 	if (OuterObject == NULL) {
 		UE_LOG(LogObjectSerializer, Error, TEXT("Cannot deserialize object %s because it's outer object %d failed deserialization (requested by %s)"), *ObjectName, OuterObjectIndex, *SourcePackage->GetName());
@@ -616,6 +938,99 @@ UObject* UObjectSerializer::DeserializeImportedObject(TSharedPtr<FJsonObject> Ob
 	return ResultObject;
 }
 
+void UObjectSerializer::WritePackage(const TSharedRef<FJsonStreamWriter>& Writer) {
+	check(SourcePackage);
+
+	bStreamingSerialization = true;
+	StreamedObjects.Reset();
+
+	const int32 FirstObjectIndex = LastObjectIndex;
+
+	// Queue every object of the package, anything they reference is queued as it is found
+	SerializeObject(SourcePackage);
+	ForEachObjectWithPackage(SourcePackage, [this](UObject* Object) {
+		if (!Object->HasAnyFlags(RF_Transient)) SerializeObject(Object);
+		return true;
+	}, false);
+
+	// Objects are queued in index order, so writing them first to last keeps the array indexable
+	Writer->WriteArrayStart();
+
+	for (int32 i = 0; i < StreamedObjects.Num(); i++) {
+		WriteObject(FirstObjectIndex + i, StreamedObjects[i], Writer);
+	}
+
+	Writer->WriteArrayEnd();
+
+	StreamedObjects.Empty();
+	bStreamingSerialization = false;
+}
+
+void UObjectSerializer::WriteObject(const int32 ObjectIndex, UObject* Object, const TSharedRef<FJsonStreamWriter>& Writer) {
+	UClass* ObjectClass = Object->GetClass();
+	UObject* OuterObject = Object->GetOuter();
+
+	Writer->WriteObjectStart();
+	Writer->WriteValue(TEXT("ObjectIndex"), ObjectIndex);
+
+	// Same fields as SerializeImportedObject
+	if (Object->GetOutermost() != SourcePackage) {
+		Writer->WriteValue(TEXT("Type"), FString(TEXT("Import")));
+		Writer->WriteValue(TEXT("ClassPackage"), ObjectClass->GetOutermost()->GetName());
+		Writer->WriteValue(TEXT("ClassName"), ObjectClass->GetName());
+
+		if (OuterObject != nullptr) {
+			Writer->WriteValue(TEXT("Outer"), SerializeObject(OuterObject));
+		}
+
+		Writer->WriteValue(TEXT("ObjectName"), Object->GetName());
+		Writer->WriteObjectEnd();
+
+		return;
+	}
+
+	Writer->WriteValue(TEXT("Type"), FString(TEXT("Export")));
+
+	if (const FString* ObjectMark = ObjectMarks.Find(Object)) {
+		Writer->WriteValue(TEXT("ObjectMark"), *ObjectMark);
+		Writer->WriteObjectEnd();
+
+		return;
+	}
+
+	// Same fields as SerializeExportedObject
+	Writer->WriteValue(TEXT("ObjectClass"), SerializeObject(ObjectClass));
+
+	if (OuterObject != nullptr) {
+		Writer->WriteValue(TEXT("Outer"), SerializeObject(OuterObject));
+		Writer->WriteValue(TEXT("ObjectName"), Object->GetName());
+		Writer->WriteValue(TEXT("ObjectFlags"), (int32)(Object->GetFlags() & RF_Load));
+
+		TArray<int32> ReferencedSubobjects;
+		Writer->WriteObjectStart(TEXT("Properties"));
+
+		for (FProperty* Property = ObjectClass->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+			if (PropertySerializer->ShouldSerializeProperty(Property)) {
+				Writer->WriteIdentifierPrefix(Property->GetName());
+				PropertySerializer->WritePropertyValue(Property, Property->ContainerPtrToValuePtr<void>(Object), Writer, &ReferencedSubobjects);
+			}
+		}
+
+		// Remove NULL from referenced subobjects because writing it down is useless
+		ReferencedSubobjects.Remove(INDEX_NONE);
+
+		Writer->WriteArrayStart(TEXT("$ReferencedObjects"));
+		for (const int32 ReferencedObjectIndex : ReferencedSubobjects) {
+			Writer->WriteValue(ReferencedObjectIndex);
+		}
+		Writer->WriteArrayEnd();
+
+		Writer->WriteObjectEnd();
+	}
+
+	Writer->WriteObjectEnd();
+}
+
 void UObjectSerializer::SerializeImportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object) {
 	// Object is imported from different package
 	UClass* ObjectClass = Object->GetClass();
@@ -0,0 +1,177 @@
+// Copyright JAA Contributors 2024-2025
+
+#include "Utilities/PackageExporter.h"
+#include "Utilities/ImportSession.h"
+#include "Utilities/ObjectUtilities.h"
+#include "Utilities/PropertyUtilities.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/StrongObjectPtr.h"
+
+#include <atomic>
+
+// Packages loaded and written at a time, everything loaded for a chunk is released before the next one
+static constexpr int32 PackageChunkSize = 64;
+
+int32 FPackageExporter::ExportPackages(const TArray<FString>& PackageNames, const FString& OutputDirectory) {
+	check(IsInGameThread());
+
+	struct FPackageExport {
+		TStrongObjectPtr<UPackage> Package;
+		TStrongObjectPtr<UObjectSerializer> Serializer;
+		TStrongObjectPtr<UPropertySerializer> PropertySerializer;
+		FString FilePath;
+	};
+
+	std::atomic<int32> ExportedPackages = 0;
+
+	for (int32 ChunkStart = 0; ChunkStart < PackageNames.Num(); ChunkStart += PackageChunkSize) {
+		const int32 ChunkEnd = FMath::Min(ChunkStart + PackageChunkSize, PackageNames.Num());
+
+		TArray<FPackageExport> Exports;
+		Exports.Reserve(ChunkEnd - ChunkStart);
+
+		// Loading packages and creating serializers has to happen on the game thread
+		for (int32 Index = ChunkStart; Index < ChunkEnd; Index++) {
+			const FString& PackageName = PackageNames[Index];
+			UPackage* Package = LoadPackage(nullptr, *PackageName, LOAD_None);
+
+			if (Package == nullptr) {
+				UE_LOG(LogJson, Warning, TEXT("Export skipped, failed to load package %s"), *PackageName);
+				continue;
+			}
+
+			UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+			UObjectSerializer* ObjectSerializer = NewObject<UObjectSerializer>();
+			ObjectSerializer->SetPropertySerializer(PropertySerializer);
+			ObjectSerializer->InitializeForSerialization(Package);
+
+			// Rooted right away, loading the next package may collect garbage
+			FPackageExport& Export = Exports.AddDefaulted_GetRef();
+			Export.Package.Reset(Package);
+			Export.Serializer.Reset(ObjectSerializer);
+			Export.PropertySerializer.Reset(PropertySerializer);
+			Export.FilePath = FPaths::Combine(OutputDirectory, PackageName + TEXT(".json"));
+		}
+
+		{
+			// Workers can't run while garbage is collected
+			FGCScopeGuard GCGuard;
+
+			ParallelFor(Exports.Num(), [&Exports, &ExportedPackages](const int32 Index) {
+				const FPackageExport& Export = Exports[Index];
+
+				const TUniquePtr<FArchive> FileWriter(IFileManager::Get().CreateFileWriter(*Export.FilePath));
+				if (!FileWriter.IsValid()) {
+					UE_LOG(LogJson, Warning, TEXT("Export skipped, failed to open %s"), *Export.FilePath);
+					return;
+				}
+
+				const TSharedRef<FJsonStreamWriter> Writer = TJsonWriterFactory<UTF8CHAR>::Create(FileWriter.Get());
+				Export.Serializer->WritePackage(Writer);
+				Writer->Close();
+
+				++ExportedPackages;
+			});
+		}
+
+		// Release this chunk before loading the next one
+		Exports.Empty();
+
+		if (ChunkEnd < PackageNames.Num()) {
+			CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+		}
+	}
+
+	return ExportedPackages;
+}
+
+int32 FPackageExporter::ExportPath(const FString& ContentPath, const FString& OutputDirectory) {
+	const IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+
+	TArray<FAssetData> Assets;
+	AssetRegistry.GetAssetsByPath(FName(*ContentPath), Assets, true);
+
+	TSet<FString> PackageNames;
+	for (const FAssetData& Asset : Assets) {
+		PackageNames.Add(Asset.PackageName.ToString());
+	}
+
+	return ExportPackages(PackageNames.Array(), OutputDirectory);
+}
+
+bool FPackageExporter::ImportPackage(const FString& FilePath, const FString& PackageName) {
+	check(IsInGameThread());
+
+	FString FileContent;
+	if (!FFileHelper::LoadFileToString(FileContent, *FilePath)) {
+		UE_LOG(LogJson, Warning, TEXT("Import skipped, failed to read %s"), *FilePath);
+		return false;
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ObjectsArray;
+	const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(FileContent);
+
+	if (!FJsonSerializer::Deserialize(Reader, ObjectsArray) || ObjectsArray.Num() == 0) {
+		UE_LOG(LogJson, Warning, TEXT("Import skipped, %s is not an exported package"), *FilePath);
+		return false;
+	}
+
+	FScopedImportSession ImportSession;
+
+	UPackage* Package = CreatePackage(*PackageName);
+	Package->FullyLoad();
+
+	UPropertySerializer* PropertySerializer = NewObject<UPropertySerializer>();
+	const TStrongObjectPtr<UObjectSerializer> ObjectSerializer(NewObject<UObjectSerializer>());
+	ObjectSerializer->SetPropertySerializer(PropertySerializer);
+	ObjectSerializer->SetPackageForDeserialization(Package);
+	ObjectSerializer->InitializeForDeserialization(ObjectsArray);
+
+	// Outers first, then properties, so no reference recurses into an export
+	ObjectSerializer->DeserializeAllExports();
+
+	ForEachObjectWithPackage(Package, [](UObject* Object) {
+		if (Object->IsAsset()) FAssetRegistryModule::AssetCreated(Object);
+		return true;
+	}, false);
+
+	Package->MarkPackageDirty();
+	return true;
+}
+
+static FAutoConsoleCommand ExportPackagesCommand(
+	TEXT("JsonAsAsset.ExportPath"),
+	TEXT("Exports every package under a content path to JSON. Usage: JsonAsAsset.ExportPath /Game/Path [OutputDirectory]"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Arguments) {
+		if (Arguments.Num() < 1) {
+			UE_LOG(LogJson, Warning, TEXT("Usage: JsonAsAsset.ExportPath /Game/Path [OutputDirectory]"));
+			return;
+		}
+
+		const FString OutputDirectory = Arguments.Num() > 1 ? Arguments[1] : FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("JsonAsAsset"), TEXT("Export"));
+		const int32 ExportedPackages = FPackageExporter::ExportPath(Arguments[0], OutputDirectory);
+
+		UE_LOG(LogJson, Log, TEXT("Exported %d packages to %s"), ExportedPackages, *OutputDirectory);
+	})
+);
+
+static FAutoConsoleCommand ImportPackageCommand(
+	TEXT("JsonAsAsset.ImportPackage"),
+	TEXT("Imports a package exported by JsonAsAsset.ExportPath. Usage: JsonAsAsset.ImportPackage File /Game/Package"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Arguments) {
+		if (Arguments.Num() < 2) {
+			UE_LOG(LogJson, Warning, TEXT("Usage: JsonAsAsset.ImportPackage File /Game/Package"));
+			return;
+		}
+
+		if (FPackageExporter::ImportPackage(Arguments[0], Arguments[1])) {
+			UE_LOG(LogJson, Log, TEXT("Imported %s into %s"), *Arguments[0], *Arguments[1]);
+		}
+	})
+);
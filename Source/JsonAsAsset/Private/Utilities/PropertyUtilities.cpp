@@ -5,6 +5,8 @@
 #include "Importers/Constructor/Importer.h"
 #include "Utilities/ObjectUtilities.h"
 #include "UObject/TextProperty.h"
+#include "Curves/RichCurve.h"
+#include "Misc/FrameRate.h"
 
 DECLARE_LOG_CATEGORY_CLASS(LogPropertySerializer, Error, Log);
 PRAGMA_DISABLE_OPTIMIZATION
@@ -90,16 +92,267 @@ bool FFallbackStructSerializer::Compare(UScriptStruct* Struct, const TSharedPtr<
 	return true;
 }
 
+/* Native struct serializers ------------------------------------------------------------------ */
+/* Hot engine structs are read straight into their memory instead of going through reflection */
+namespace NativeStructs {
+	template <typename T>
+	void Read(const FJsonObject& Json, const TCHAR* Field, T& Out) {
+		if (const TSharedPtr<FJsonValue>* Value = Json.Values.Find(Field)) {
+			double Number;
+			if ((*Value)->TryGetNumber(Number)) Out = static_cast<T>(Number);
+		}
+	}
+
+	void Read(const FJsonObject& Json, const TCHAR* Field, bool& Out) {
+		if (const TSharedPtr<FJsonValue>* Value = Json.Values.Find(Field)) {
+			double Number;
+			if ((*Value)->TryGetNumber(Number)) Out = Number != 0.0;
+			else (*Value)->TryGetBool(Out);
+		}
+	}
+
+	template <typename TEnum>
+	void ReadEnum(const FJsonObject& Json, const TCHAR* Field, TEnumAsByte<TEnum>& Out) {
+		if (const TSharedPtr<FJsonValue>* Value = Json.Values.Find(Field)) {
+			if ((*Value)->Type == EJson::String) {
+				const int64 EnumValue = StaticEnum<TEnum>()->GetValueByNameString((*Value)->AsString());
+				if (EnumValue != INDEX_NONE) Out = static_cast<TEnum>(EnumValue);
+			} else {
+				Out = static_cast<TEnum>((*Value)->AsNumber());
+			}
+		}
+	}
+
+	const FJsonObject* FindObjectField(const FJsonObject& Json, const TCHAR* Field) {
+		const TSharedPtr<FJsonValue>* Value = Json.Values.Find(Field);
+		if (Value == nullptr || (*Value)->Type != EJson::Object) return nullptr;
+
+		return (*Value)->AsObject().Get();
+	}
+
+	template <typename T>
+	void Write(FJsonObject& Json, const TCHAR* Field, const T Value) {
+		Json.SetNumberField(Field, static_cast<double>(Value));
+	}
+
+	template <typename TEnum>
+	void WriteEnum(FJsonObject& Json, const TCHAR* Field, const TEnumAsByte<TEnum> Value) {
+		Json.SetStringField(Field, StaticEnum<TEnum>()->GetNameStringByValue(static_cast<int64>(Value.GetValue())));
+	}
+
+	template <typename TStruct>
+	void WriteObject(FJsonObject& Json, const TCHAR* Field, const TStruct& Value);
+
+	/* Vectors */
+	template <typename T> void ReadStruct(const FJsonObject& Json, UE::Math::TVector<T>& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); Read(Json, TEXT("Z"), Out.Z); }
+	template <typename T> void WriteStruct(FJsonObject& Json, const UE::Math::TVector<T>& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); Write(Json, TEXT("Z"), In.Z); }
+
+	template <typename T> void ReadStruct(const FJsonObject& Json, UE::Math::TVector2<T>& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); }
+	template <typename T> void WriteStruct(FJsonObject& Json, const UE::Math::TVector2<T>& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); }
+
+	template <typename T> void ReadStruct(const FJsonObject& Json, UE::Math::TVector4<T>& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); Read(Json, TEXT("Z"), Out.Z); Read(Json, TEXT("W"), Out.W); }
+	template <typename T> void WriteStruct(FJsonObject& Json, const UE::Math::TVector4<T>& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); Write(Json, TEXT("Z"), In.Z); Write(Json, TEXT("W"), In.W); }
+
+	void ReadStruct(const FJsonObject& Json, FIntPoint& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); }
+	void WriteStruct(FJsonObject& Json, const FIntPoint& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); }
+
+	void ReadStruct(const FJsonObject& Json, FIntVector& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); Read(Json, TEXT("Z"), Out.Z); }
+	void WriteStruct(FJsonObject& Json, const FIntVector& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); Write(Json, TEXT("Z"), In.Z); }
+
+	/* Rotations */
+	template <typename T> void ReadStruct(const FJsonObject& Json, UE::Math::TRotator<T>& Out) { Read(Json, TEXT("Pitch"), Out.Pitch); Read(Json, TEXT("Yaw"), Out.Yaw); Read(Json, TEXT("Roll"), Out.Roll); }
+	template <typename T> void WriteStruct(FJsonObject& Json, const UE::Math::TRotator<T>& In) { Write(Json, TEXT("Pitch"), In.Pitch); Write(Json, TEXT("Yaw"), In.Yaw); Write(Json, TEXT("Roll"), In.Roll); }
+
+	template <typename T> void ReadStruct(const FJsonObject& Json, UE::Math::TQuat<T>& Out) { Read(Json, TEXT("X"), Out.X); Read(Json, TEXT("Y"), Out.Y); Read(Json, TEXT("Z"), Out.Z); Read(Json, TEXT("W"), Out.W); }
+	template <typename T> void WriteStruct(FJsonObject& Json, const UE::Math::TQuat<T>& In) { Write(Json, TEXT("X"), In.X); Write(Json, TEXT("Y"), In.Y); Write(Json, TEXT("Z"), In.Z); Write(Json, TEXT("W"), In.W); }
+
+	/* Colors */
+	void ReadStruct(const FJsonObject& Json, FLinearColor& Out) { Read(Json, TEXT("R"), Out.R); Read(Json, TEXT("G"), Out.G); Read(Json, TEXT("B"), Out.B); Read(Json, TEXT("A"), Out.A); }
+	void WriteStruct(FJsonObject& Json, const FLinearColor& In) { Write(Json, TEXT("R"), In.R); Write(Json, TEXT("G"), In.G); Write(Json, TEXT("B"), In.B); Write(Json, TEXT("A"), In.A); }
+
+	void ReadStruct(const FJsonObject& Json, FColor& Out) { Read(Json, TEXT("R"), Out.R); Read(Json, TEXT("G"), Out.G); Read(Json, TEXT("B"), Out.B); Read(Json, TEXT("A"), Out.A); }
+	void WriteStruct(FJsonObject& Json, const FColor& In) { Write(Json, TEXT("R"), In.R); Write(Json, TEXT("G"), In.G); Write(Json, TEXT("B"), In.B); Write(Json, TEXT("A"), In.A); }
+
+	/* Misc */
+	void ReadStruct(const FJsonObject& Json, FGuid& Out) { Read(Json, TEXT("A"), Out.A); Read(Json, TEXT("B"), Out.B); Read(Json, TEXT("C"), Out.C); Read(Json, TEXT("D"), Out.D); }
+	void WriteStruct(FJsonObject& Json, const FGuid& In) { Write(Json, TEXT("A"), In.A); Write(Json, TEXT("B"), In.B); Write(Json, TEXT("C"), In.C); Write(Json, TEXT("D"), In.D); }
+
+	void ReadStruct(const FJsonObject& Json, FFloatInterval& Out) { Read(Json, TEXT("Min"), Out.Min); Read(Json, TEXT("Max"), Out.Max); }
+	void WriteStruct(FJsonObject& Json, const FFloatInterval& In) { Write(Json, TEXT("Min"), In.Min); Write(Json, TEXT("Max"), In.Max); }
+
+	void ReadStruct(const FJsonObject& Json, FFrameNumber& Out) { Read(Json, TEXT("Value"), Out.Value); }
+	void WriteStruct(FJsonObject& Json, const FFrameNumber& In) { Write(Json, TEXT("Value"), In.Value); }
+
+	void ReadStruct(const FJsonObject& Json, FFrameRate& Out) { Read(Json, TEXT("Numerator"), Out.Numerator); Read(Json, TEXT("Denominator"), Out.Denominator); }
+	void WriteStruct(FJsonObject& Json, const FFrameRate& In) { Write(Json, TEXT("Numerator"), In.Numerator); Write(Json, TEXT("Denominator"), In.Denominator); }
+
+	void ReadStruct(const FJsonObject& Json, FRichCurveKey& Out) {
+		ReadEnum(Json, TEXT("InterpMode"), Out.InterpMode);
+		ReadEnum(Json, TEXT("TangentMode"), Out.TangentMode);
+		ReadEnum(Json, TEXT("TangentWeightMode"), Out.TangentWeightMode);
+		Read(Json, TEXT("Time"), Out.Time);
+		Read(Json, TEXT("Value"), Out.Value);
+		Read(Json, TEXT("ArriveTangent"), Out.ArriveTangent);
+		Read(Json, TEXT("ArriveTangentWeight"), Out.ArriveTangentWeight);
+		Read(Json, TEXT("LeaveTangent"), Out.LeaveTangent);
+		Read(Json, TEXT("LeaveTangentWeight"), Out.LeaveTangentWeight);
+	}
+
+	void WriteStruct(FJsonObject& Json, const FRichCurveKey& In) {
+		WriteEnum(Json, TEXT("InterpMode"), In.InterpMode);
+		WriteEnum(Json, TEXT("TangentMode"), In.TangentMode);
+		WriteEnum(Json, TEXT("TangentWeightMode"), In.TangentWeightMode);
+		Write(Json, TEXT("Time"), In.Time);
+		Write(Json, TEXT("Value"), In.Value);
+		Write(Json, TEXT("ArriveTangent"), In.ArriveTangent);
+		Write(Json, TEXT("ArriveTangentWeight"), In.ArriveTangentWeight);
+		Write(Json, TEXT("LeaveTangent"), In.LeaveTangent);
+		Write(Json, TEXT("LeaveTangentWeight"), In.LeaveTangentWeight);
+	}
+
+	/* Composites */
+	template <typename T>
+	void ReadStruct(const FJsonObject& Json, UE::Math::TBox<T>& Out) {
+		if (const FJsonObject* Min = FindObjectField(Json, TEXT("Min"))) ReadStruct(*Min, Out.Min);
+		if (const FJsonObject* Max = FindObjectField(Json, TEXT("Max"))) ReadStruct(*Max, Out.Max);
+		Read(Json, TEXT("IsValid"), Out.IsValid);
+	}
+
+	template <typename T>
+	void WriteStruct(FJsonObject& Json, const UE::Math::TBox<T>& In) {
+		WriteObject(Json, TEXT("Min"), In.Min);
+		WriteObject(Json, TEXT("Max"), In.Max);
+		Write(Json, TEXT("IsValid"), In.IsValid);
+	}
+
+	template <typename T>
+	void ReadStruct(const FJsonObject& Json, UE::Math::TBox2<T>& Out) {
+		if (const FJsonObject* Min = FindObjectField(Json, TEXT("Min"))) ReadStruct(*Min, Out.Min);
+		if (const FJsonObject* Max = FindObjectField(Json, TEXT("Max"))) ReadStruct(*Max, Out.Max);
+		Read(Json, TEXT("bIsValid"), Out.bIsValid);
+		Read(Json, TEXT("IsValid"), Out.bIsValid);
+	}
+
+	template <typename T>
+	void WriteStruct(FJsonObject& Json, const UE::Math::TBox2<T>& In) {
+		WriteObject(Json, TEXT("Min"), In.Min);
+		WriteObject(Json, TEXT("Max"), In.Max);
+		Json.SetBoolField(TEXT("bIsValid"), In.bIsValid);
+	}
+
+	template <typename T>
+	void ReadStruct(const FJsonObject& Json, UE::Math::TTransform<T>& Out) {
+		if (const FJsonObject* Rotation = FindObjectField(Json, TEXT("Rotation"))) {
+			UE::Math::TQuat<T> Value = Out.GetRotation();
+			ReadStruct(*Rotation, Value);
+			Out.SetRotation(Value);
+		}
+
+		if (const FJsonObject* Translation = FindObjectField(Json, TEXT("Translation"))) {
+			UE::Math::TVector<T> Value = Out.GetTranslation();
+			ReadStruct(*Translation, Value);
+			Out.SetTranslation(Value);
+		}
+
+		if (const FJsonObject* Scale = FindObjectField(Json, TEXT("Scale3D"))) {
+			UE::Math::TVector<T> Value = Out.GetScale3D();
+			ReadStruct(*Scale, Value);
+			Out.SetScale3D(Value);
+		}
+	}
+
+	template <typename T>
+	void WriteStruct(FJsonObject& Json, const UE::Math::TTransform<T>& In) {
+		WriteObject(Json, TEXT("Rotation"), In.GetRotation());
+		WriteObject(Json, TEXT("Translation"), In.GetTranslation());
+		WriteObject(Json, TEXT("Scale3D"), In.GetScale3D());
+	}
+
+	template <typename TStruct>
+	void WriteObject(FJsonObject& Json, const TCHAR* Field, const TStruct& Value) {
+		const TSharedRef<FJsonObject> Object = MakeShared<FJsonObject>();
+		WriteStruct(*Object, Value);
+		Json.SetObjectField(Field, Object);
+	}
+
+	template <typename TStruct>
+	class TNativeStructSerializer final : public FStructSerializer {
+	public:
+		virtual void Serialize(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, TArray<int32>* OutReferencedSubobjects) override {
+			WriteStruct(*JsonValue, *static_cast<const TStruct*>(StructData));
+		}
+
+		virtual void Deserialize(UScriptStruct* Struct, void* StructData, const TSharedPtr<FJsonObject> JsonValue) override {
+			ReadStruct(*JsonValue, *static_cast<TStruct*>(StructData));
+		}
+
+		// Fields missing from the JSON are left as is, same as the fallback serializer
+		virtual bool Compare(UScriptStruct* Struct, const TSharedPtr<FJsonObject> JsonValue, const void* StructData, const TSharedPtr<FObjectCompareContext> Context) override {
+			TStruct Value = *static_cast<const TStruct*>(StructData);
+			ReadStruct(*JsonValue, Value);
+
+			return Struct->CompareScriptStruct(&Value, StructData, PPF_None);
+		}
+	};
+
+	using FStructTable = TArray<TPair<UScriptStruct*, TSharedPtr<FStructSerializer>>>;
+
+	template <typename TStruct>
+	void Register(FStructTable& Table, const TCHAR* StructPath) {
+		// Not every engine version has every struct (e.g. float variants)
+		if (UScriptStruct* Struct = FindObject<UScriptStruct>(NULL, StructPath)) {
+			Table.Emplace(Struct, MakeShared<TNativeStructSerializer<TStruct>>());
+		}
+	}
+
+	// Structs are resolved once, the serializers hold no state so every property serializer shares them
+	const FStructTable& GetStructTable() {
+		static const FStructTable Table = [] {
+			FStructTable Result;
+
+			UScriptStruct* DateTimeStruct = FindObject<UScriptStruct>(NULL, TEXT("/Script/CoreUObject.DateTime"));
+			UScriptStruct* TimespanStruct = FindObject<UScriptStruct>(NULL, TEXT("/Script/CoreUObject.Timespan"));
+			check(DateTimeStruct);
+			check(TimespanStruct);
+
+			Result.Emplace(DateTimeStruct, MakeShared<FDateTimeSerializer>());
+			Result.Emplace(TimespanStruct, MakeShared<FTimespanSerializer>());
+
+			Register<FVector>(Result, TEXT("/Script/CoreUObject.Vector"));
+			Register<FVector3f>(Result, TEXT("/Script/CoreUObject.Vector3f"));
+			Register<FVector2D>(Result, TEXT("/Script/CoreUObject.Vector2D"));
+			Register<FVector2f>(Result, TEXT("/Script/CoreUObject.Vector2f"));
+			Register<FVector4>(Result, TEXT("/Script/CoreUObject.Vector4"));
+			Register<FVector4f>(Result, TEXT("/Script/CoreUObject.Vector4f"));
+			Register<FIntPoint>(Result, TEXT("/Script/CoreUObject.IntPoint"));
+			Register<FIntVector>(Result, TEXT("/Script/CoreUObject.IntVector"));
+			Register<FRotator>(Result, TEXT("/Script/CoreUObject.Rotator"));
+			Register<FQuat>(Result, TEXT("/Script/CoreUObject.Quat"));
+			Register<FLinearColor>(Result, TEXT("/Script/CoreUObject.LinearColor"));
+			Register<FColor>(Result, TEXT("/Script/CoreUObject.Color"));
+			Register<FGuid>(Result, TEXT("/Script/CoreUObject.Guid"));
+			Register<FBox>(Result, TEXT("/Script/CoreUObject.Box"));
+			Register<FBox2D>(Result, TEXT("/Script/CoreUObject.Box2D"));
+			Register<FTransform>(Result, TEXT("/Script/CoreUObject.Transform"));
+			Register<FFloatInterval>(Result, TEXT("/Script/CoreUObject.FloatInterval"));
+			Register<FFrameNumber>(Result, TEXT("/Script/CoreUObject.FrameNumber"));
+			Register<FFrameRate>(Result, TEXT("/Script/CoreUObject.FrameRate"));
+			Register<FRichCurveKey>(Result, TEXT("/Script/Engine.RichCurveKey"));
+
+			return Result;
+		}();
+
+		return Table;
+	}
+}
+
 UPropertySerializer::UPropertySerializer() {
+	this->Importer = nullptr;
 	this->FallbackStructSerializer = MakeShared<FFallbackStructSerializer>(this);
 
-	UScriptStruct* DateTimeStruct = FindObject<UScriptStruct>(NULL, TEXT("/Script/CoreUObject.DateTime"));
-	UScriptStruct* TimespanStruct = FindObject<UScriptStruct>(NULL, TEXT("/Script/CoreUObject.Timespan"));
-	check(DateTimeStruct);
-	check(TimespanStruct);
-
-	this->StructSerializers.Add(DateTimeStruct, MakeShared<FDateTimeSerializer>());
-	this->StructSerializers.Add(TimespanStruct, MakeShared<FTimespanSerializer>());
+	for (const TPair<UScriptStruct*, TSharedPtr<FStructSerializer>>& Entry : NativeStructs::GetStructTable()) {
+		AddStructSerializer(Entry.Key, Entry.Value);
+	}
 }
 
 void UPropertySerializer::DeserializePropertyValue(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, void* Value) {
@@ -134,6 +387,9 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		FScriptMapHelper MapHelper(MapProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& PairArray = NewJsonValue->AsArray();
 
+		// Reserve every pair up front, pairs are constructed in place and hashed once at the end
+		MapHelper.EmptyValues(PairArray.Num());
+
 		for (int32 i = 0; i < PairArray.Num(); i++) {
 			const TSharedPtr<FJsonObject>& Pair = PairArray[i]->AsObject();
 			const TSharedPtr<FJsonValue>& EntryKey = Pair->Values.FindChecked(TEXT("Key"));
@@ -141,7 +397,6 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 			const int32 Index = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
 			uint8* PairPtr = MapHelper.GetPairPtr(Index);
 
-			// Copy over imported key and value from temporary storage
 			DeserializePropertyValue(KeyProperty, EntryKey.ToSharedRef(), PairPtr);
 			DeserializePropertyValue(ValueProperty, EntryValue.ToSharedRef(), PairPtr + MapHelper.MapLayout.ValueOffset);
 		}
@@ -151,35 +406,32 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		FProperty* ElementProperty = SetProperty->ElementProp;
 		FScriptSetHelper SetHelper(SetProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = NewJsonValue->AsArray();
-		SetHelper.EmptyElements();
-		uint8* TempElementStorage = static_cast<uint8*>(FMemory::Malloc(ElementProperty->ElementSize));
-		ElementProperty->InitializeValue(TempElementStorage);
+
+		// Same as maps, no temporary element storage is needed when deserializing in place
+		SetHelper.EmptyElements(SetArray.Num());
 
 		for (int32 i = 0; i < SetArray.Num(); i++) {
 			const TSharedPtr<FJsonValue>& Element = SetArray[i];
-			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), TempElementStorage);
-
 			const int32 NewElementIndex = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
-			uint8* NewElementPtr = SetHelper.GetElementPtr(NewElementIndex);
 
-			// Copy over imported key from temporary storage
-			ElementProperty->CopyCompleteValue_InContainer(NewElementPtr, TempElementStorage);
+			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), SetHelper.GetElementPtr(NewElementIndex));
 		}
 		SetHelper.Rehash();
-
-		ElementProperty->DestroyValue(TempElementStorage);
-		FMemory::Free(TempElementStorage);
 	} else if (ArrayProperty) {
 		FProperty* ElementProperty = ArrayProperty->Inner;
 		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
 		const TArray<TSharedPtr<FJsonValue>>& SetArray = NewJsonValue->AsArray();
 		ArrayHelper.EmptyValues();
 
-		for (int32 i = 0; i < SetArray.Num(); i++) {
-			const TSharedPtr<FJsonValue>& Element = SetArray[i];
-			const uint32 AddedIndex = ArrayHelper.AddValue();
-			uint8* ValuePtr = ArrayHelper.GetRawPtr(AddedIndex);
-			DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), ValuePtr);
+		// Size the array once, elements are default constructed
+		ArrayHelper.Resize(SetArray.Num());
+
+		if (!DeserializeArrayElementsFast(ElementProperty, ArrayHelper, SetArray)) {
+			for (int32 i = 0; i < SetArray.Num(); i++) {
+				const TSharedPtr<FJsonValue>& Element = SetArray[i];
+				uint8* ValuePtr = ArrayHelper.GetRawPtr(i);
+				DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), ValuePtr);
+			}
 		}
 	}
 	else if (Property->IsA<FMulticastDelegateProperty>()) {
@@ -205,14 +457,26 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 		// Need to serialize full UObject for object property
 		TObjectPtr<UObject> Object = NULL;
 
-		// Use IImporter to import the object
-		IImporter* Importer = new IImporter();
-		Importer->LoadObject(&NewJsonValue->AsObject(), Object);
+		// Indexed packages reference objects by their index, otherwise
+		// serializers not owned by an importer resolve references through an empty one
+		if (NewJsonValue->Type == EJson::Number) {
+			Object = ObjectSerializer ? ObjectSerializer->DeserializeObject((int32)NewJsonValue->AsNumber()) : NULL;
+		} else if (Importer != nullptr) {
+			Importer->LoadObject(&NewJsonValue->AsObject(), Object);
+		} else {
+			IImporter ReferenceImporter;
+			ReferenceImporter.LoadObject(&NewJsonValue->AsObject(), Object);
+		}
 		ObjectProperty->SetObjectPropertyValue(Value, Object);
 	}
 	else if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
 		// JSON for FGuids are FStrings
 		if (FString OutString; JsonValue->TryGetString(OutString)) {
+			if (StructProperty->Struct == TBaseStructure<FGuid>::Get()) {
+				FGuid::Parse(OutString, *static_cast<FGuid*>(Value));
+				return;
+			}
+
 			FGuid GUID = FGuid(OutString); // Create GUID from String
 
 			TSharedRef<FJsonObject> SharedObject = MakeShareable(new FJsonObject());
@@ -289,6 +553,83 @@ void UPropertySerializer::DeserializePropertyValueInner(FProperty* Property, con
 	}
 }
 
+template <typename T>
+static void WriteNumberElements(uint8* Data, const TArray<TSharedPtr<FJsonValue>>& Elements) {
+	T* Values = reinterpret_cast<T*>(Data);
+
+	for (int32 i = 0; i < Elements.Num(); i++) {
+		Values[i] = static_cast<T>(Elements[i]->AsNumber());
+	}
+}
+
+bool UPropertySerializer::DeserializeArrayElementsFast(FProperty* ElementProperty, FScriptArrayHelper& ArrayHelper, const TArray<TSharedPtr<FJsonValue>>& Elements) {
+	if (Elements.Num() == 0 || ElementProperty->ArrayDim != 1) {
+		return Elements.Num() == 0;
+	}
+
+	uint8* Data = ArrayHelper.GetRawPtr(0);
+	const int32 Stride = ElementProperty->ElementSize;
+
+	// Numbers, bytes with an enum are written as strings and take the slow path
+	if (const FNumericProperty* NumberProperty = CastField<const FNumericProperty>(ElementProperty)) {
+		if (NumberProperty->IsEnum()) return false;
+
+		if (ElementProperty->IsA<FFloatProperty>()) WriteNumberElements<float>(Data, Elements);
+		else if (ElementProperty->IsA<FDoubleProperty>()) WriteNumberElements<double>(Data, Elements);
+		else if (ElementProperty->IsA<FIntProperty>()) WriteNumberElements<int32>(Data, Elements);
+		else if (ElementProperty->IsA<FByteProperty>()) WriteNumberElements<uint8>(Data, Elements);
+		else if (NumberProperty->IsFloatingPoint()) {
+			for (int32 i = 0; i < Elements.Num(); i++) {
+				NumberProperty->SetFloatingPointPropertyValue(Data + i * Stride, Elements[i]->AsNumber());
+			}
+		} else {
+			for (int32 i = 0; i < Elements.Num(); i++) {
+				NumberProperty->SetIntPropertyValue(Data + i * Stride, static_cast<int64>(Elements[i]->AsNumber()));
+			}
+		}
+
+		return true;
+	}
+
+	if (const FBoolProperty* BoolProperty = CastField<const FBoolProperty>(ElementProperty)) {
+		for (int32 i = 0; i < Elements.Num(); i++) {
+			BoolProperty->SetPropertyValue(Data + i * Stride, Elements[i]->AsBool());
+		}
+
+		return true;
+	}
+
+	if (ElementProperty->IsA<FNameProperty>()) {
+		FName* Names = reinterpret_cast<FName*>(Data);
+
+		for (int32 i = 0; i < Elements.Num(); i++) {
+			Names[i] = FName(*Elements[i]->AsString());
+		}
+
+		return true;
+	}
+
+	// Structs with a native serializer, anything that isn't a plain object (e.g. GUID strings) goes through the usual path
+	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(ElementProperty)) {
+		const TSharedPtr<FStructSerializer>* StructSerializer = StructSerializers.Find(StructProperty->Struct);
+		if (StructSerializer == nullptr || !StructSerializer->IsValid()) return false;
+
+		for (int32 i = 0; i < Elements.Num(); i++) {
+			const TSharedPtr<FJsonValue>& Element = Elements[i];
+
+			if (Element->Type == EJson::Object) {
+				(*StructSerializer)->Deserialize(StructProperty->Struct, Data + i * Stride, Element->AsObject());
+			} else {
+				DeserializePropertyValue(ElementProperty, Element.ToSharedRef(), Data + i * Stride);
+			}
+		}
+
+		return true;
+	}
+
+	return false;
+}
+
 void UPropertySerializer::DisablePropertySerialization(UStruct* Struct, FName PropertyName) {
 	FProperty* Property = Struct->FindPropertyByName(PropertyName);
 	checkf(Property, TEXT("Cannot find Property %s in Struct %s"), *PropertyName.ToString(), *Struct->GetPathName());
@@ -301,6 +642,10 @@ void UPropertySerializer::AddStructSerializer(UScriptStruct* Struct, const TShar
 	this->StructSerializers.Add(Struct, Serializer);
 }
 
+void UPropertySerializer::RemoveStructSerializer(UScriptStruct* Struct) {
+	this->StructSerializers.Remove(Struct);
+}
+
 bool UPropertySerializer::ShouldSerializeProperty(FProperty* Property) const {
 	// Skip transient properties
 	if (Property->HasAnyPropertyFlags(CPF_Transient)) {
@@ -488,6 +833,107 @@ TSharedRef<FJsonObject> UPropertySerializer::SerializeStruct(UScriptStruct* Stru
 	return JsonObject;
 }
 
+void UPropertySerializer::WritePropertyValue(FProperty* Property, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects) {
+	// Statically sized array properties
+	if (Property->ArrayDim != 1) {
+		Writer->WriteArrayStart();
+
+		for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
+			const uint8* ArrayPropertyValue = (const uint8*)Value + Property->ElementSize * ArrayIndex;
+			WritePropertyValueInner(Property, ArrayPropertyValue, Writer, OutReferencedSubobjects);
+		}
+
+		Writer->WriteArrayEnd();
+	} else {
+		WritePropertyValueInner(Property, Value, Writer, OutReferencedSubobjects);
+	}
+}
+
+void UPropertySerializer::WritePropertyValueInner(FProperty* Property, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects) {
+	if (const FMapProperty* MapProperty = CastField<const FMapProperty>(Property)) {
+		FScriptMapHelper MapHelper(MapProperty, Value);
+		Writer->WriteArrayStart();
+
+		for (int32 i = 0; i < MapHelper.GetMaxIndex(); i++) {
+			if (!MapHelper.IsValidIndex(i)) continue;
+
+			Writer->WriteObjectStart();
+			Writer->WriteIdentifierPrefix(TEXT("Key"));
+			WritePropertyValue(MapProperty->KeyProp, MapHelper.GetKeyPtr(i), Writer, OutReferencedSubobjects);
+			Writer->WriteIdentifierPrefix(TEXT("Value"));
+			WritePropertyValue(MapProperty->ValueProp, MapHelper.GetValuePtr(i), Writer, OutReferencedSubobjects);
+			Writer->WriteObjectEnd();
+		}
+
+		Writer->WriteArrayEnd();
+		return;
+	}
+
+	if (const FSetProperty* SetProperty = CastField<const FSetProperty>(Property)) {
+		FScriptSetHelper SetHelper(SetProperty, Value);
+		Writer->WriteArrayStart();
+
+		for (int32 i = 0; i < SetHelper.GetMaxIndex(); i++) {
+			if (!SetHelper.IsValidIndex(i)) continue;
+
+			WritePropertyValue(SetProperty->ElementProp, SetHelper.GetElementPtr(i), Writer, OutReferencedSubobjects);
+		}
+
+		Writer->WriteArrayEnd();
+		return;
+	}
+
+	if (const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property)) {
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+		Writer->WriteArrayStart();
+
+		for (int32 i = 0; i < ArrayHelper.Num(); i++) {
+			WritePropertyValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), Writer, OutReferencedSubobjects);
+		}
+
+		Writer->WriteArrayEnd();
+		return;
+	}
+
+	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+		WriteStruct(StructProperty->Struct, Value, Writer, OutReferencedSubobjects);
+		return;
+	}
+
+	// Every other type is a leaf, write the same value SerializePropertyValue would produce
+	const TSharedRef<FJsonValue> JsonValue = SerializePropertyValueInner(Property, Value, OutReferencedSubobjects);
+
+	switch (JsonValue->Type) {
+		case EJson::Number: Writer->WriteValue(JsonValue->AsNumber()); break;
+		case EJson::Boolean: Writer->WriteValue(JsonValue->AsBool()); break;
+		case EJson::String: Writer->WriteValue(JsonValue->AsString()); break;
+		default: Writer->WriteNull(); break;
+	}
+}
+
+void UPropertySerializer::WriteStruct(UScriptStruct* Struct, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects) {
+	FStructSerializer* StructSerializer = GetStructSerializer(Struct);
+
+	// Custom serializers only produce small objects, write those through the DOM
+	if (StructSerializer != FallbackStructSerializer.Get()) {
+		const TSharedRef<FJsonObject> StructJson = SerializeStruct(Struct, Value, OutReferencedSubobjects);
+		FJsonSerializer::Serialize(MakeShared<FJsonValueObject>(StructJson), FString(), Writer, false);
+
+		return;
+	}
+
+	Writer->WriteObjectStart();
+
+	for (FProperty* Property = Struct->PropertyLink; Property; Property = Property->PropertyLinkNext) {
+		if (ShouldSerializeProperty(Property)) {
+			Writer->WriteIdentifierPrefix(Property->GetName());
+			WritePropertyValue(Property, Property->ContainerPtrToValuePtr<void>(Value), Writer, OutReferencedSubobjects);
+		}
+	}
+
+	Writer->WriteObjectEnd();
+}
+
 void UPropertySerializer::DeserializeStruct(UScriptStruct* Struct, const TSharedRef<FJsonObject>& Properties, void* OutValue) {
 	FStructSerializer* StructSerializer = GetStructSerializer(Struct);
 	StructSerializer->Deserialize(Struct, OutValue, Properties);
@@ -620,12 +1066,40 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 		return ObjectSerializer->CompareObjectsWithContext(InterfaceObjectIndex, InterfaceObject, Context);
 	}
 
-	if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
-		//Need to serialize full UObject for object property
+	// Soft paths are compared after deserializing below, that never loads anything
+	const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property);
+	if (ObjectProperty && !Property->IsA<FSoftObjectProperty>()) {
 		UObject* PropertyObject = ObjectProperty->GetObjectPropertyValue(CurrentValue);
-		const int32 ObjectIndex = JsonValue->AsNumber();
 
-		return ObjectSerializer->CompareObjectsWithContext(ObjectIndex, PropertyObject, Context);
+		// Indices refer to serialized objects
+		if (JsonValue->Type == EJson::Number) {
+			const int32 ObjectIndex = JsonValue->AsNumber();
+
+			return ObjectSerializer->CompareObjectsWithContext(ObjectIndex, PropertyObject, Context);
+		}
+
+		// References by path are compared by path, deserializing them could load, import or download the asset
+		const TSharedPtr<FJsonObject>* ReferenceObject;
+		if (!JsonValue->TryGetObject(ReferenceObject)) {
+			return PropertyObject == nullptr;
+		}
+
+		if (PropertyObject == nullptr) {
+			return false;
+		}
+
+		FString ObjectName, ObjectPath, AssetName;
+		(*ReferenceObject)->GetStringField(TEXT("ObjectName")).Split("'", nullptr, &ObjectName);
+		(*ReferenceObject)->GetStringField(TEXT("ObjectPath")).Split(".", &ObjectPath, nullptr);
+
+		ObjectPath = IImporter::NormalizeObjectPath(ObjectPath);
+		ObjectName = ObjectName.Replace(TEXT("'"), TEXT(""));
+		ObjectPath.Split("/", nullptr, &AssetName, ESearchCase::IgnoreCase, ESearchDir::FromEnd);
+
+		// Same paths IImporter::LoadObject tries, material expressions live inside of their asset
+		const FString CurrentPath = PropertyObject->GetPathName();
+
+		return CurrentPath == ObjectPath + "." + ObjectName || CurrentPath == ObjectPath + "." + AssetName + ":" + ObjectName;
 	}
 
 	//To serialize struct, we need it's type and value pointer, because struct value doesn't contain type information
@@ -647,6 +1121,109 @@ bool UPropertySerializer::ComparePropertyValuesInner(FProperty* Property, const
 	return Property->Identical(CurrentValue, DeserializedElement.GetObjAddress(), PPF_None);
 }
 
+uint32 UPropertySerializer::HashPropertyValue(FProperty* Property, const void* Value, bool& bOutReferencesObjects) const {
+	uint32 Hash = 0;
+
+	for (int32 ArrayIndex = 0; ArrayIndex < Property->ArrayDim; ArrayIndex++) {
+		const uint8* ArrayPropertyValue = (const uint8*)Value + Property->ElementSize * ArrayIndex;
+		Hash = HashCombine(Hash, HashPropertyValueInner(Property, ArrayPropertyValue, bOutReferencesObjects));
+	}
+
+	return Hash;
+}
+
+uint32 UPropertySerializer::HashPropertyValueInner(FProperty* Property, const void* Value, bool& bOutReferencesObjects) const {
+	if (const FMapProperty* MapProperty = CastField<const FMapProperty>(Property)) {
+		FScriptMapHelper MapHelper(MapProperty, Value);
+
+		// Pair hashes are summed, maps are unordered
+		uint32 PairsHash = 0;
+		for (int32 i = 0; i < MapHelper.GetMaxIndex(); i++) {
+			if (!MapHelper.IsValidIndex(i)) continue;
+
+			PairsHash += HashCombine(
+				HashPropertyValue(MapProperty->KeyProp, MapHelper.GetKeyPtr(i), bOutReferencesObjects),
+				HashPropertyValue(MapProperty->ValueProp, MapHelper.GetValuePtr(i), bOutReferencesObjects));
+		}
+
+		return HashCombine(MapHelper.Num(), PairsHash);
+	}
+
+	if (const FSetProperty* SetProperty = CastField<const FSetProperty>(Property)) {
+		FScriptSetHelper SetHelper(SetProperty, Value);
+
+		uint32 ElementsHash = 0;
+		for (int32 i = 0; i < SetHelper.GetMaxIndex(); i++) {
+			if (!SetHelper.IsValidIndex(i)) continue;
+
+			ElementsHash += HashPropertyValue(SetProperty->ElementProp, SetHelper.GetElementPtr(i), bOutReferencesObjects);
+		}
+
+		return HashCombine(SetHelper.Num(), ElementsHash);
+	}
+
+	if (const FArrayProperty* ArrayProperty = CastField<const FArrayProperty>(Property)) {
+		FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+
+		uint32 Hash = ArrayHelper.Num();
+		for (int32 i = 0; i < ArrayHelper.Num(); i++) {
+			Hash = HashCombine(Hash, HashPropertyValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(i), bOutReferencesObjects));
+		}
+
+		return Hash;
+	}
+
+	if (Property->IsA<FInterfaceProperty>()) {
+		UObject* InterfaceObject = static_cast<const FScriptInterface*>(Value)->GetObject();
+		bOutReferencesObjects |= InterfaceObject != nullptr;
+
+		return GetTypeHash(InterfaceObject);
+	}
+
+	if (const FSoftObjectProperty* SoftObjectProperty = CastField<const FSoftObjectProperty>(Property)) {
+		return GetTypeHash(SoftObjectProperty->GetPropertyValue(Value).ToSoftObjectPath().ToString());
+	}
+
+	if (const FObjectPropertyBase* ObjectProperty = CastField<const FObjectPropertyBase>(Property)) {
+		UObject* PropertyObject = ObjectProperty->GetObjectPropertyValue(Value);
+		bOutReferencesObjects |= PropertyObject != nullptr;
+
+		return GetTypeHash(PropertyObject);
+	}
+
+	if (const FStructProperty* StructProperty = CastField<const FStructProperty>(Property)) {
+		UScriptStruct* Struct = StructProperty->Struct;
+
+		if (Struct->GetCppStructOps() && Struct->GetCppStructOps()->HasGetTypeHash()) {
+			return Struct->GetStructTypeHash(Value);
+		}
+
+		uint32 Hash = GetTypeHash(Struct);
+		for (FProperty* StructMember = Struct->PropertyLink; StructMember; StructMember = StructMember->PropertyLinkNext) {
+			if (ShouldSerializeProperty(StructMember)) {
+				Hash = HashCombine(Hash, HashPropertyValue(StructMember, StructMember->ContainerPtrToValuePtr<void>(Value), bOutReferencesObjects));
+			}
+		}
+
+		return Hash;
+	}
+
+	if (const FTextProperty* TextProperty = CastField<const FTextProperty>(Property)) {
+		return GetTypeHash(TextProperty->GetPropertyValue(Value).ToString());
+	}
+
+	if (const FBoolProperty* BoolProperty = CastField<const FBoolProperty>(Property)) {
+		return GetTypeHash(BoolProperty->GetPropertyValue(Value));
+	}
+
+	if (Property->HasAllPropertyFlags(CPF_HasGetValueTypeHash)) {
+		return Property->GetValueTypeHash(Value);
+	}
+
+	// Anything left (delegates and the like) isn't deserialized from JSON
+	return 0;
+}
+
 bool UPropertySerializer::CompareStructs(UScriptStruct* Struct, const TSharedRef<FJsonObject>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context) {
 	FStructSerializer* StructSerializer = GetStructSerializer(Struct);
 	return StructSerializer->Compare(Struct, JsonValue, CurrentValue, Context);
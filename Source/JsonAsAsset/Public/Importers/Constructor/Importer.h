@@ -22,6 +22,7 @@ public:
           Package(Package), OutermostPkg(OutermostPkg), AllJsonObjects(AllJsonObjects) 
     {
         PropertySerializer = NewObject<UPropertySerializer>();
+        PropertySerializer->SetImporter(this);
         GObjectSerializer = NewObject<UObjectSerializer>();
         GObjectSerializer->SetPropertySerializer(PropertySerializer);
     }
@@ -112,7 +113,11 @@ public:
     }
 
     void ImportReference(const FString& File);
+    void ImportReferences(const TArray<FString>& Files);
     bool ImportAssetReference(const FString& GamePath);
+    FString GetLocalReferencePath(const FString& GamePath) const;
+    static bool ReadExportsFile(const FString& File, TArray<TSharedPtr<FJsonValue>>& OutExports);
+    static FString NormalizeObjectPath(const FString& ObjectPath);
     bool ImportExports(TArray<TSharedPtr<FJsonValue>> Exports, FString File, bool bHideNotifications = false);
 
     TSharedPtr<FJsonObject> GetExport(FJsonObject* PackageIndex);
@@ -131,6 +136,10 @@ protected:
     // Shortcut to calling SavePackage and HandleAssetCreation
     bool OnAssetCreation(UObject* Asset);
 
+    // Writes only changed properties into the asset if it already exists and patching is enabled
+    // Returns true if the asset was patched, and shouldn't be created again
+    bool PatchExistingAsset(const UClass* AssetClass, const TSharedPtr<FJsonObject>& Properties);
+
     template <class T = UObject>
     TObjectPtr<T> DownloadWrapper(TObjectPtr<T> InObject, FString Type, FString Name, FString Path);
 
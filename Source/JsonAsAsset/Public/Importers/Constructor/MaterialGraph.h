@@ -7,6 +7,54 @@
 #include "Widgets/Notifications/SNotificationList.h"
 #include "Framework/Notifications/NotificationManager.h"
 
+/* One expression export, parsed ahead of object creation */
+struct FMaterialExpressionIR {
+	FName Name;
+	FName Type;
+
+	FJsonObject* Export = nullptr;
+	FJsonObject* Properties = nullptr;
+
+	// Export names of the expressions connected to this expression's inputs
+	TArray<FName> Inputs;
+
+	// Only set for parameters and function calls
+	FName ParameterName;
+	FString FunctionPath;
+};
+
+/*
+ * Flat view of a material graph, built from the JSON in parallel and validated
+ * before any object is created, so the game thread only creates and links.
+ */
+struct FMaterialGraphIR {
+	TArray<FMaterialExpressionIR> Expressions;
+	TMap<FName, int32> ExpressionIndices;
+
+	// Reroutes left out of a lean import, and the input each one passes through (null if unconnected)
+	TMap<FName, TSharedPtr<FJsonObject>> BypassedReroutes;
+
+	// Anything that makes the graph unusable, the asset isn't created if set
+	TArray<FString> Errors;
+
+	bool IsValid() const { return Errors.IsEmpty(); }
+};
+
+/*
+ * While in scope, expression inputs (and every material input deriving from them)
+ * are linked straight to the expressions already constructed for the graph, by
+ * name, instead of loading each reference through its object path.
+ */
+class FScopedExpressionInputLinking {
+public:
+	FScopedExpressionInputLinking(UPropertySerializer* PropertySerializer, const TMap<FName, UMaterialExpression*>& Expressions, const TMap<FName, TSharedPtr<FJsonObject>>& BypassedReroutes);
+	~FScopedExpressionInputLinking();
+
+private:
+	UPropertySerializer* PropertySerializer;
+	TArray<UScriptStruct*> Structs;
+};
+
 // Material Graph Handler
 // Handles everything needed to create a material graph from JSON.
 class IMaterialGraph : public IImporter {
@@ -60,12 +108,36 @@ protected:
 	void MaterialGraphNode_ExpressionWrapper(UObject* Parent, UMaterialExpression* Expression, const TSharedPtr<FJsonObject>& Json);
 	void MaterialGraphNode_ConstructComments(UObject* Parent, const TSharedPtr<FJsonObject>& Json, TMap<FName, FExportData>& Exports);
 
+	// Imports every missing material function the exports call, and the functions those call,
+	// dependencies first, so the graph doesn't stop at each function call to import it
+	void PrefetchMaterialFunctions(const TMap<FName, FExportData>& Exports);
+
+	// Parses every expression off the game thread, and checks connections stay inside the graph
+	static FMaterialGraphIR BuildGraphIR(const FString& Outer, const TArray<FName>& ExpressionNames, const TMap<FName, FExportData>& Exports);
+
+	// Reports the errors of an invalid graph, returns false if the asset shouldn't be created
+	bool ValidateGraphIR(const FMaterialGraphIR& Graph) const;
+
+	// Hash of every export in the file, the same for copies of a graph at other paths
+	FString HashMaterialGraph() const;
+
+	// Hashes the graph if deduplication is enabled, and handles this asset if an identical one was imported
+	// before it. Returns true if the asset was handled as a duplicate, and shouldn't be built.
+	bool HandleDuplicateGraph(FString& OutGraphHash);
+
+	// Leaves reroutes out of the graph, and stops node positions from being imported
+	void PrepareLeanImport(FMaterialGraphIR& Graph, const TMap<FName, FExportData>& Exports);
+
 	// Makes each expression with their class
-	TMap<FName, UMaterialExpression*> ConstructExpressions(UObject* Parent, const FString& Outer, TArray<FName>& ExpressionNames, TMap<FName, FExportData>& Exports);
+	TMap<FName, UMaterialExpression*> ConstructExpressions(UObject* Parent, const FMaterialGraphIR& Graph);
 	UMaterialExpression* CreateEmptyExpression(UObject* Parent, FName Name, FName Type, FJsonObject* LocalizedObject);
 
 	// Modifies Graph Nodes (copies over properties from FJsonObject)
 	void PropagateExpressions(UObject* Parent, TArray<FName>& ExpressionNames, TMap<FName, FExportData>& Exports, TMap<FName, UMaterialExpression*>& CreatedExpressionMap, bool bCheckOuter = false, bool bSubgraph = false);
+
+	// Replaces quality, feature level and shading path switches with the branch chosen in the settings,
+	// and removes the expressions left unused by it
+	void CollapseMaterialSwitches(UObject* Parent);
 	// ----------------------------------------------------
 
 	// Functions to Handle Node Connections ------------
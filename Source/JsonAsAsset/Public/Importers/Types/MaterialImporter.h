@@ -15,7 +15,7 @@ public:
 	virtual bool ImportData() override;
 
 	// Subgraph Functions
-	// still not done :[
+	UMaterialExpressionComposite* ConstructComposite(UMaterial* Material, const FString& GraphName, const FJsonObject* SubgraphExpressionObject, TMap<FName, UMaterialExpression*>& CreatedExpressionMap, TMap<FName, FExportData>& Exports);
 	void ComposeExpressionPinBase(UMaterialExpressionPinBase* Pin, TMap<FName, UMaterialExpression*>& CreatedExpressionMap, const TSharedPtr<FJsonObject>& _JsonObject, TMap<FName, FExportData>& Exports);
 	TArray<TSharedPtr<FJsonValue>> FilterGraphNodesBySubgraphExpression(const FString& Outer);
 };
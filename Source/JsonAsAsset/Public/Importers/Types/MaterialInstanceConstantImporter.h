@@ -4,6 +4,22 @@
 
 #include "../Constructor/Importer.h"
 
+class UMaterialInterface;
+
+/* A parent shared by instances of a batch, resolved and read once for all of them */
+struct FMaterialInstanceBatchParent {
+	UMaterialInterface* Parent = nullptr;
+
+	// Names of the parameters the parent has, empty if they couldn't be listed
+	TSet<FName> ScalarNames;
+	TSet<FName> VectorNames;
+	TSet<FName> TextureNames;
+	TSet<FName> StaticSwitchNames;
+	TSet<FName> StaticComponentMaskNames;
+
+	bool bHasLayout = false;
+};
+
 class UMaterialInstanceConstantImporter : public IImporter {
 public:
 	UMaterialInstanceConstantImporter(const FString& FileName, const FString& FilePath, const TSharedPtr<FJsonObject>& JsonObject, UPackage* Package, UPackage* OutermostPkg, const TArray<TSharedPtr<FJsonValue>>& AllJsonObjects):
@@ -11,4 +27,20 @@ public:
 	}
 
 	virtual bool ImportData() override;
+
+	// If the file holds a single instance, and nothing else to import
+	static bool IsInstanceFile(const TArray<TSharedPtr<FJsonValue>>& Exports);
+
+	/*
+	 * Imports many instance files at once. Instances are grouped by parent from
+	 * their JSON, and each parent is resolved and has its parameters listed once
+	 * for the whole group. Importers are only created while their instance is
+	 * imported. Parents among the files are imported before their children, and
+	 * every instance is compiled together at the end.
+	 */
+	static void ImportBatch(const TArray<FString>& Files, const TArray<TArray<TSharedPtr<FJsonValue>>>& FileExports);
+
+private:
+	// Set for instances imported in a batch
+	const FMaterialInstanceBatchParent* BatchParent = nullptr;
 };
@@ -0,0 +1,65 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Logging/TokenizedMessage.h"
+#include "Containers/Ticker.h"
+
+enum class EImportDiagnosticCategory : uint8 {
+	Imported,
+	Patched,
+	ImportFailed,
+	MissingData,
+	InvalidData,
+	MissingClass,
+	MissingReference,
+	Download,
+	Duplicate
+};
+
+/*
+ * Collects the messages of every importer during an import session, instead of
+ * showing a notification for each one. Messages with the same category and text
+ * are merged, keeping the list of assets they came from.
+ *
+ * Flushed when the outermost FScopedImportSession ends (or on the next tick outside
+ * of one), into a single message log page, a summary notification when the editor
+ * UI is up, and Saved/JsonAsAsset/ImportReport.json.
+ */
+class FImportDiagnostics {
+public:
+	static FImportDiagnostics& Get();
+
+	void Add(EMessageSeverity::Type Severity, EImportDiagnosticCategory Category, const FString& Message, const FString& AssetName = FString());
+
+	void Info(EImportDiagnosticCategory Category, const FString& Message, const FString& AssetName = FString()) { Add(EMessageSeverity::Info, Category, Message, AssetName); }
+	void Warning(EImportDiagnosticCategory Category, const FString& Message, const FString& AssetName = FString()) { Add(EMessageSeverity::Warning, Category, Message, AssetName); }
+	void Error(EImportDiagnosticCategory Category, const FString& Message, const FString& AssetName = FString()) { Add(EMessageSeverity::Error, Category, Message, AssetName); }
+
+	// Reports everything collected so far, and clears it
+	void Flush();
+
+	static const TCHAR* GetCategoryName(EImportDiagnosticCategory Category);
+
+private:
+	struct FEntry {
+		EMessageSeverity::Type Severity;
+		EImportDiagnosticCategory Category;
+		FString Message;
+		TSet<FString> Assets;
+		int32 Count = 0;
+	};
+
+	void WriteReport() const;
+	void ShowSummary() const;
+	void LogEntry(const FEntry& Entry, const FString& Text) const;
+
+	// Pending flush of messages added outside of a session
+	FTSTicker::FDelegateHandle FlushTickerHandle;
+
+	TArray<FEntry> Entries;
+
+	// Category and message -> Index into Entries
+	TMap<TPair<EImportDiagnosticCategory, FString>, int32> EntryIndices;
+};
@@ -0,0 +1,180 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "StaticParameterSet.h"
+
+class UMaterial;
+class UMaterialInterface;
+class UMaterialInstanceConstant;
+
+// Hashes of the JSON properties an object last matched and of its property memory at that point
+struct FObjectFingerprint {
+	uint64 JsonHash = 0;
+	uint32 MemoryHash = 0;
+
+	// Referenced objects can change without the memory hash changing
+	bool bReferencesObjects = false;
+};
+
+/*
+ * State shared by every importer during a single import run (one press of the
+ * import button, or every file selected in the dialog).
+ *
+ * Opened with FScopedImportSession, cleared once the outermost scope ends.
+ */
+class FImportSession {
+public:
+	static FImportSession& Get();
+
+	bool IsActive() const { return ScopeDepth > 0; }
+
+	/* Object References ---------------------------------------------------- */
+	/*
+	 * Looks up a previously resolved object reference.
+	 * 
+	 * @return true if the reference was resolved before, OutObject is null for a negative result
+	 */
+	bool FindReference(const FString& Key, UObject*& OutObject) const;
+	void AddReference(const FString& Key, UObject* Object);
+
+	// Drops a cached result, used once an asset is created at that path
+	void ForgetReference(const FString& ObjectPath);
+
+	/* Classes -------------------------------------------------------------- */
+	/*
+	 * Resolves a native class by its short name (e.g. "Material") or its full
+	 * path, from any script package. Renamed classes are followed through
+	 * class redirects, other names fall back to any loaded class (e.g.
+	 * blueprint generated classes).
+	 *
+	 * The name -> class table is built once, on first use, and rebuilt for every
+	 * session. Only native classes are cached.
+	 */
+	UClass* FindClass(const FString& ClassName);
+
+	/*
+	 * Resolves the class of a material expression type, including expressions
+	 * moved to other modules under a new name. Results, and failures, are cached
+	 * for the whole session.
+	 */
+	UClass* FindExpressionClass(const FString& ExpressionType);
+
+	/* Archetypes ----------------------------------------------------------- */
+	/*
+	 * GetArchetypeFromRequiredInfo, cached by class, the outer's archetype and name
+	 * without its number suffix. Only numbered names resolving to the class default
+	 * object are cached. A hit is only used if the outer's archetype has no subobject
+	 * with the full name, numbered names can be instanced there too (e.g. components
+	 * added in a blueprint).
+	 */
+	UObject* FindArchetype(UClass* Class, UObject* Outer, FName Name, EObjectFlags Flags);
+
+	/* Object Fingerprints -------------------------------------------------- */
+	/*
+	 * Fingerprint of an object that was compared as up to date, or patched, by an
+	 * earlier import. Kept across sessions until the object is garbage collected,
+	 * the memory hash tells whether it was modified since.
+	 */
+	const FObjectFingerprint* FindObjectFingerprint(UObject* Object) const;
+	void SetObjectFingerprint(UObject* Object, const FObjectFingerprint& Fingerprint);
+
+	/* Duplicate Graphs ----------------------------------------------------- */
+	/*
+	 * The first material or function imported with a structural hash, later
+	 * assets with the same hash are duplicates of it.
+	 */
+	UObject* FindCanonicalGraph(const FString& GraphHash) const;
+
+	// Only the first asset registered with a hash is kept
+	void AddCanonicalGraph(const FString& GraphHash, UObject* Asset);
+
+	/* Material Compilation ------------------------------------------------- */
+	/*
+	 * While deferring, importers skip their per-asset recompiles and register the
+	 * material or instance here instead. Everything registered is compiled once,
+	 * in a single update context, when the outermost scope ends.
+	 */
+	bool IsDeferringMaterialUpdates() const;
+
+	void DeferMaterialUpdate(UMaterialInterface* Material);
+
+	// Static parameters are applied at flush, so only the final state is compiled
+	void DeferStaticPermutationUpdate(UMaterialInstanceConstant* Instance, const FStaticParameterSet& StaticParameters);
+
+	// Runs PostEditChange on materials first, then on instances ordered parents first
+	void FlushMaterialUpdates();
+
+	void Reset();
+
+private:
+	friend class FScopedImportSession;
+	friend class FScopedMaterialUpdateDeferral;
+
+	struct FCachedReference {
+		TWeakObjectPtr<UObject> Object;
+		bool bFound = false;
+	};
+
+	// ObjectPath.ObjectName -> Resolved object (or a negative result)
+	TMap<FString, FCachedReference> References;
+
+	void BuildClassTable();
+	UClass* FindRedirectedClass(FName ClassName) const;
+
+	// Short class name -> Class (null for names that failed to resolve)
+	TMap<FName, UClass*> Classes;
+	TArray<FName> ScriptPackageNames;
+	bool bClassTableBuilt = false;
+
+	// Expression type -> Class (null for types missing in this build)
+	TMap<FName, UClass*> ExpressionClasses;
+
+	struct FArchetypeKey {
+		UClass* Class;
+		// Outers with a per-instance template resolve subobjects from it, not from the class default object
+		UObject* OuterArchetype;
+		FName BaseName;
+		EObjectFlags Flags;
+
+		bool operator==(const FArchetypeKey& Other) const {
+			return Class == Other.Class && OuterArchetype == Other.OuterArchetype && BaseName == Other.BaseName && Flags == Other.Flags;
+		}
+
+		friend uint32 GetTypeHash(const FArchetypeKey& Key) {
+			return HashCombine(HashCombine(GetTypeHash(Key.Class), GetTypeHash(Key.OuterArchetype)), HashCombine(GetTypeHash(Key.BaseName), GetTypeHash(Key.Flags)));
+		}
+	};
+
+	TMap<FArchetypeKey, TWeakObjectPtr<UObject>> Archetypes;
+
+	// Garbage collected objects don't match their stale entries anymore, those are pruned on reset
+	TMap<TWeakObjectPtr<UObject>, FObjectFingerprint> ObjectFingerprints;
+
+	// Structural hash -> First asset imported with it
+	TMap<FString, TWeakObjectPtr<UObject>> CanonicalGraphs;
+
+	TSet<TWeakObjectPtr<UMaterial>> DeferredMaterials;
+	TSet<TWeakObjectPtr<UMaterialInstanceConstant>> DeferredInstances;
+	TMap<TWeakObjectPtr<UMaterialInstanceConstant>, FStaticParameterSet> DeferredStaticParameters;
+
+	int32 ScopeDepth = 0;
+
+	// Scopes deferring material updates regardless of the setting
+	int32 ForcedDeferralDepth = 0;
+};
+
+// Opens an import session for the lifetime of this object, can be nested
+class FScopedImportSession {
+public:
+	FScopedImportSession();
+	~FScopedImportSession();
+};
+
+// Defers material updates to the end of the session while in scope, even if the setting is off
+class FScopedMaterialUpdateDeferral {
+public:
+	FScopedMaterialUpdateDeferral() { FImportSession::Get().ForcedDeferralDepth++; }
+	~FScopedMaterialUpdateDeferral() { FImportSession::Get().ForcedDeferralDepth--; }
+};
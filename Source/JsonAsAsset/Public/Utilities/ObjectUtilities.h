@@ -8,6 +8,9 @@
 
 class UPropertySerializer;
 
+/** Writer used to stream exports straight to disk */
+using FJsonStreamWriter = TJsonWriter<UTF8CHAR>;
+
 /** Compare settings for one specific object */
 struct JSONASASSET_API FObjectCompareSettings {
     /** Whenever to perform a name check on the objects */
@@ -20,7 +23,7 @@ struct JSONASASSET_API FObjectCompareSettings {
 };
 
 class JSONASASSET_API FObjectCompareContext {
-    TArray<TPair<int32, UObject*>> ObjectsAlreadyCompared;
+    TSet<TPair<int32, UObject*>> ObjectsAlreadyCompared;
     TMap<int32, FObjectCompareSettings> CompareSettings;
 public:
     FObjectCompareContext();
@@ -30,6 +33,20 @@ public:
     FObjectCompareSettings GetObjectSettings(int32 ObjectIndex) const;
 };
 
+/** Shared between package collection calls, so objects and packages already collected are skipped */
+struct FPackageCollectionState {
+    /** A bit per object index */
+    TBitArray<> VisitedObjects;
+    /** Every package name added to the output through this state */
+    TSet<FString> PackageNames;
+};
+
+/** 64-bit content hash of JSON values, object fields are hashed regardless of their order */
+struct JSONASASSET_API FJsonHash {
+    static uint64 Hash(const FJsonValue& Value);
+    static uint64 Hash(const FJsonObject& Object);
+};
+
 UCLASS()
 class JSONASASSET_API UObjectSerializer : public UObject {
     GENERATED_BODY()
@@ -38,14 +55,40 @@ private:
         UPackage* SourcePackage;
     UPROPERTY()
         TMap<UObject*, int32> ObjectIndices;
+
+    /** Objects are addressed by their dense index, LoadedObjectFlags tells which entries were resolved (possibly to null) */
     UPROPERTY()
-        TMap<int32, UObject*> LoadedObjects;
+        TArray<UObject*> LoadedObjects;
+    TBitArray<> LoadedObjectFlags;
+
     int32 LastObjectIndex;
     UPROPERTY()
         UPropertySerializer* PropertySerializer;
-    TMap<int32, TSharedPtr<FJsonObject>> SerializedObjects;
+    TArray<TSharedPtr<FJsonObject>> SerializedObjects;
+
+    /** Marks are looked up both ways */
     UPROPERTY()
         TMap<UObject*, FString> ObjectMarks;
+    UPROPERTY()
+        TMap<FString, UObject*> MarkedObjects;
+
+    /** Indices every object was loaded at, so marked objects can be remapped when their mark moves */
+    TMultiMap<UObject*, int32> LoadedObjectIndices;
+
+    /** Exports grouped by outer and class index, so siblings are constructed together */
+    TMap<TPair<int32, int32>, TArray<int32>> SiblingExports;
+
+    /** Objects constructed along with a sibling, their properties are deserialized once requested */
+    TBitArray<> PendingPropertyFlags;
+    TArray<int32> PendingPropertyObjects;
+    int32 ExportDepth;
+
+    /** Set while DeserializeAllExports runs, references return objects without filling their properties */
+    bool bDeferPendingProperties;
+
+    /** Set while WritePackage runs, SerializeObject only hands out indices and queues objects to be written in order */
+    bool bStreamingSerialization;
+    TArray<UObject*> StreamedObjects;
 public:
     UObjectSerializer();
 
@@ -65,6 +108,14 @@ public:
 
     void FlushPropertiesIntoObject(const int32 ObjectIndex, UObject* Object, bool bVerifyNameAndRename, bool bVerifyOuterAndMove);
     void DeserializeObjectProperties(const TSharedPtr<FJsonObject>& Properties, UObject* Object);
+
+    /**
+     * Writes only the properties whose JSON differs from the object's current values, each one
+     * wrapped in its own PreEditChange/PostEditChangeProperty. Struct members are diffed one by one.
+     *
+     * @return Paths of every property written (e.g. "Settings.Scale")
+     */
+    TArray<FString> ApplyPropertyPatch(const TSharedPtr<FJsonObject>& Properties, UObject* Object);
     void SetPropertySerializer(UPropertySerializer* NewPropertySerializer);
 
     void InitializeForSerialization(UPackage* NewSourcePackage);
@@ -81,30 +132,75 @@ public:
 
     UObject* DeserializeObject(int32 Index);
 
+    /**
+     * Deserializes every export in two phases instead of on demand:
+     * all exports are allocated first (outers before their subobjects), then
+     * properties are filled in a flat loop, where every reference is already loaded.
+     */
+    void DeserializeAllExports();
+
     int32 SerializeObject(UObject* Object);
 
     TArray<TSharedPtr<FJsonValue>> FinalizeSerialization();
 
-    void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames);
+    /**
+     * Writes every object of the source package (and the imports they reference) as the
+     * same array FinalizeSerialization returns, without building JSON objects in memory.
+     * Only touches this serializer, so different packages can be written from different threads.
+     */
+    void WritePackage(const TSharedRef<FJsonStreamWriter>& Writer);
 
-    void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized);
+    void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames);
+    void CollectReferencedPackages(const TArray<TSharedPtr<FJsonValue>>& ReferencedSubobjects, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State);
 
     FORCEINLINE void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames) {
-        TArray<int32> ObjectsAlreadySerialized;
-        CollectObjectPackages(ObjectIndex, OutReferencedPackageNames, ObjectsAlreadySerialized);
+        FPackageCollectionState State;
+        State.PackageNames.Append(OutReferencedPackageNames);
+
+        CollectObjectPackages(ObjectIndex, OutReferencedPackageNames, State);
     }
 
-    void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, TArray<int32>& ObjectsAlreadySerialized);
+    void CollectObjectPackages(const int32 ObjectIndex, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State);
 
     FString GetObjectFullPath(int32 ObjectIndex);
 
     FORCEINLINE static const TSet<FName>& GetUnhandledNativeClasses() { return UnhandledNativeClasses; }
+
+    /** Hashes every serializable property value of the object */
+    uint32 HashObjectProperties(UObject* Object, bool& bOutReferencesObjects) const;
 private:
     static TSet<FName> UnhandledNativeClasses;
 
+    enum class EFingerprintMatch : uint8 {
+        Unknown,
+        UpToDate,
+        OutOfDate
+    };
+
+    /** Records that the object matches these properties, done once they were compared or patched */
+    void RecordObjectFingerprint(const FJsonObject& Properties, UObject* Object) const;
+
+    /** Matches the properties against the fingerprint of the object, Unknown if it has none or was modified since */
+    EFingerprintMatch MatchObjectFingerprint(const FJsonObject& Properties, UObject* Object) const;
+
+    void PatchPropertyValue(UObject* Object, FProperty* MemberProperty, FProperty* Property, void* Value, const TSharedRef<FJsonValue>& JsonValue, const FString& PropertyPath, TArray<FString>& OutChangedPaths);
+
+    FORCEINLINE bool IsValidObjectIndex(const int32 Index) const { return SerializedObjects.IsValidIndex(Index); }
+    FORCEINLINE bool IsObjectLoaded(const int32 Index) const { return LoadedObjectFlags.IsValidIndex(Index) && LoadedObjectFlags[Index]; }
+    void SetLoadedObject(int32 Index, UObject* Object);
+
+    /** Walks objects on the stack and everything they depend on, without recursion */
+    void CollectPackages(TArray<int32>& ObjectStack, TArray<FString>& OutReferencedPackageNames, FPackageCollectionState& State);
+
     void SerializeImportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
     void SerializeExportedObject(TSharedPtr<FJsonObject> ResultJson, UObject* Object);
+    void WriteObject(int32 ObjectIndex, UObject* Object, const TSharedRef<FJsonStreamWriter>& Writer);
 
     UObject* DeserializeImportedObject(TSharedPtr<FJsonObject> ObjectJson);
     UObject* DeserializeExportedObject(int32 ObjectIndex, TSharedPtr<FJsonObject> ObjectJson);
+
+    UObject* ConstructExportedObject(UClass* ObjectClass, UObject* OuterObject, const TSharedPtr<FJsonObject>& ObjectJson);
+    void DeserializeExportedProperties(const TSharedPtr<FJsonObject>& ObjectJson, UObject* Object);
+    void DeserializePendingProperties(int32 ObjectIndex);
+    void FlushPendingProperties();
 };
\ No newline at end of file
@@ -0,0 +1,35 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Exports packages back to JSON through UObjectSerializer, mainly to diff our
+ * own assets. Packages don't share any serializer state, so they are written in
+ * parallel, each one streamed straight to its own file. Exported files can be
+ * imported back into a package with ImportPackage.
+ */
+class FPackageExporter {
+public:
+	/*
+	 * Writes <OutputDirectory>/<PackageName>.json for every package.
+	 * Must be called from the game thread. Packages are loaded and written in
+	 * bounded chunks, garbage is collected between chunks.
+	 *
+	 * @return Number of packages exported
+	 */
+	static int32 ExportPackages(const TArray<FString>& PackageNames, const FString& OutputDirectory);
+
+	// Exports every package under a content path (e.g. /Game/Materials)
+	static int32 ExportPath(const FString& ContentPath, const FString& OutputDirectory);
+
+	/*
+	 * Re-creates a package from a file written by ExportPackages. Every export
+	 * is allocated before any property is read (see DeserializeAllExports).
+	 * Must be called from the game thread.
+	 *
+	 * @return Whether the file was read and deserialized
+	 */
+	static bool ImportPackage(const FString& FilePath, const FString& PackageName);
+};
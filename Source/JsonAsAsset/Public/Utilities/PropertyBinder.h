@@ -0,0 +1,133 @@
+// Copyright JAA Contributors 2024-2025
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Dom/JsonObject.h"
+#include "Utilities/MathUtilities.h"
+
+/* Conversions from a JSON value into a native member, used by TPropertyBinder */
+namespace JsonBinding {
+	template <typename T, typename TEnableIf<TIsArithmetic<T>::Value, int>::Type = 0>
+	void ReadValue(const FJsonValue& Value, T& Out) {
+		if (double Number; Value.TryGetNumber(Number)) Out = static_cast<T>(Number);
+	}
+
+	inline void ReadValue(const FJsonValue& Value, bool& Out) {
+		if (double Number; Value.TryGetNumber(Number)) Out = Number != 0.0;
+		else Value.TryGetBool(Out);
+	}
+
+	// Enums are exported by name, but accept raw values too
+	template <typename TEnum>
+	bool ReadEnumValue(const FJsonValue& Value, TEnum& Out) {
+		if (Value.Type == EJson::String) {
+			const int64 EnumValue = StaticEnum<TEnum>()->GetValueByNameString(Value.AsString());
+			if (EnumValue == INDEX_NONE) return false;
+
+			Out = static_cast<TEnum>(EnumValue);
+			return true;
+		}
+
+		if (double Number; Value.TryGetNumber(Number)) {
+			Out = static_cast<TEnum>(static_cast<int64>(Number));
+			return true;
+		}
+
+		return false;
+	}
+
+	template <typename TEnum>
+	void ReadValue(const FJsonValue& Value, TEnumAsByte<TEnum>& Out) {
+		if (TEnum EnumValue; ReadEnumValue(Value, EnumValue)) Out = EnumValue;
+	}
+
+	template <typename TEnum, typename TEnableIf<TIsEnum<TEnum>::Value, int>::Type = 0>
+	void ReadValue(const FJsonValue& Value, TEnum& Out) {
+		ReadEnumValue(Value, Out);
+	}
+
+	inline void ReadValue(const FJsonValue& Value, FString& Out) { Value.TryGetString(Out); }
+	inline void ReadValue(const FJsonValue& Value, FName& Out) { if (FString String; Value.TryGetString(String)) Out = FName(*String); }
+	inline void ReadValue(const FJsonValue& Value, FGuid& Out) { if (FString String; Value.TryGetString(String)) FGuid::Parse(String, Out); }
+
+	inline void ReadValue(const FJsonValue& Value, FVector& Out) { if (Value.Type == EJson::Object) Out = FMathUtilities::ObjectToVector(Value.AsObject().Get()); }
+	inline void ReadValue(const FJsonValue& Value, FRotator& Out) { if (Value.Type == EJson::Object) Out = FMathUtilities::ObjectToRotator(Value.AsObject().Get()); }
+	inline void ReadValue(const FJsonValue& Value, FLinearColor& Out) { if (Value.Type == EJson::Object) Out = FMathUtilities::ObjectToLinearColor(Value.AsObject().Get()); }
+	inline void ReadValue(const FJsonValue& Value, FColor& Out) { if (Value.Type == EJson::Object) Out = FMathUtilities::ObjectToColor(Value.AsObject().Get()); }
+
+	inline void ReadValue(const FJsonValue& Value, FVector4& Out) {
+		if (Value.Type != EJson::Object) return;
+
+		const TSharedPtr<FJsonObject> Object = Value.AsObject();
+		Object->TryGetNumberField(TEXT("X"), Out.X);
+		Object->TryGetNumberField(TEXT("Y"), Out.Y);
+		Object->TryGetNumberField(TEXT("Z"), Out.Z);
+		Object->TryGetNumberField(TEXT("W"), Out.W);
+	}
+}
+
+/*
+ * Maps JSON keys to members of a native type, so hand-written importer code can
+ * fill every known field in a single pass over the JSON object, instead of one
+ * lookup per field.
+ *
+ * Build the table once, and apply it as many times as needed:
+ *
+ *	static const TPropertyBinder<USkeletalMeshSocket> SocketBinder = TPropertyBinder<USkeletalMeshSocket>()
+ *		.Bind(TEXT("RelativeLocation"), &USkeletalMeshSocket::RelativeLocation)
+ *		.BindBool(TEXT("bSomeBitfield"), [](USkeletalMeshSocket& Socket, const bool bValue) { Socket.bSomeBitfield = bValue; });
+ *
+ *	SocketBinder.Apply(Properties, *Socket);
+ */
+template <typename TObject>
+class TPropertyBinder {
+public:
+	using FSetter = TFunction<void(TObject&, const FJsonValue&)>;
+
+	// Binds a JSON key directly to a member
+	template <typename TOwner, typename TValue>
+	TPropertyBinder& Bind(const TCHAR* Key, TValue TOwner::* Member) {
+		static_assert(TIsDerivedFrom<TObject, TOwner>::Value, "Member must belong to the bound type");
+
+		Setters.Add(Key, [Member](TObject& Object, const FJsonValue& Value) {
+			JsonBinding::ReadValue(Value, Object.*Member);
+		});
+
+		return *this;
+	}
+
+	// Binds a JSON key to custom handling
+	TPropertyBinder& Bind(const TCHAR* Key, FSetter Setter) {
+		Setters.Add(Key, MoveTemp(Setter));
+		return *this;
+	}
+
+	// Bitfields can't be pointed to, so they are set through a function
+	TPropertyBinder& BindBool(const TCHAR* Key, void (*Setter)(TObject&, bool)) {
+		Setters.Add(Key, [Setter](TObject& Object, const FJsonValue& Value) {
+			bool bValue = false;
+			JsonBinding::ReadValue(Value, bValue);
+
+			Setter(Object, bValue);
+		});
+
+		return *this;
+	}
+
+	// Fills every bound member present in the JSON object
+	void Apply(const TSharedPtr<FJsonObject>& Json, TObject& Object) const {
+		if (!Json.IsValid()) return;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Field : Json->Values) {
+			if (!Field.Value.IsValid()) continue;
+
+			if (const FSetter* Setter = Setters.Find(Field.Key)) {
+				(*Setter)(Object, *Field.Value);
+			}
+		}
+	}
+
+private:
+	TMap<FString, FSetter> Setters;
+};
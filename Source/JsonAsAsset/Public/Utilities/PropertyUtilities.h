@@ -8,6 +8,8 @@
 #include "PropertyUtilities.generated.h"
 
 class UObjectSerializer;
+class FScriptArrayHelper;
+class IImporter;
 
 /** Handles struct serialization */
 class JSONASASSET_API FStructSerializer
@@ -58,6 +60,9 @@ class JSONASASSET_API UPropertySerializer : public UObject
 	UPROPERTY()
 	UObjectSerializer* ObjectSerializer;
 
+	/** Importer owning this serializer, object references are loaded through it */
+	IImporter* Importer;
+
 	UPROPERTY()
 	TArray<UStruct*> PinnedStructs;
 	TArray<FProperty*> BlacklistedProperties;
@@ -71,6 +76,8 @@ public:
 	/** Disables property serialization entirely */
 	void DisablePropertySerialization(UStruct* Struct, FName PropertyName);
 	void AddStructSerializer(UScriptStruct* Struct, const TSharedPtr<FStructSerializer>& Serializer);
+	void RemoveStructSerializer(UScriptStruct* Struct);
+	void SetImporter(IImporter* NewImporter) { Importer = NewImporter; }
 
 	/** Checks whenever we should serialize property in question at all */
 	bool ShouldSerializeProperty(FProperty* Property) const;
@@ -78,9 +85,16 @@ public:
 	TSharedRef<FJsonValue> SerializePropertyValue(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
 	TSharedRef<FJsonObject> SerializeStruct(UScriptStruct* Struct, const void* Value, TArray<int32>* OutReferencedSubobjects = NULL);
 
+	/** Streaming versions of the above, the value is written at the writer's current position (after an identifier, or inside an array) */
+	void WritePropertyValue(FProperty* Property, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects = NULL);
+	void WriteStruct(UScriptStruct* Struct, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects = NULL);
+
 	void DeserializePropertyValue(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
 	void DeserializeStruct(UScriptStruct* Struct, const TSharedRef<FJsonObject>& Value, void* OutValue);
 
+	/** Hashes the value of a property, equal values always produce the same hash. Referenced objects are hashed by identity, not contents */
+	uint32 HashPropertyValue(FProperty* Property, const void* Value, bool& bOutReferencesObjects) const;
+
 	bool ComparePropertyValues(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context = MakeShareable(new FObjectCompareContext));
 	bool CompareStructs(UScriptStruct* Struct, const TSharedRef<FJsonObject>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context = MakeShareable(new FObjectCompareContext));
 
@@ -88,5 +102,10 @@ private:
 	FStructSerializer* GetStructSerializer(UScriptStruct* Struct) const;
 	bool ComparePropertyValuesInner(FProperty* Property, const TSharedRef<FJsonValue>& JsonValue, const void* CurrentValue, const TSharedPtr<FObjectCompareContext> Context);
 	void DeserializePropertyValueInner(FProperty* Property, const TSharedRef<FJsonValue>& Value, void* OutValue);
+	uint32 HashPropertyValueInner(FProperty* Property, const void* Value, bool& bOutReferencesObjects) const;
+
+	/** Writes primitive and natively serialized struct elements in a single pass, returns false if the element type isn't supported */
+	bool DeserializeArrayElementsFast(FProperty* ElementProperty, FScriptArrayHelper& ArrayHelper, const TArray<TSharedPtr<FJsonValue>>& Elements);
 	TSharedRef<FJsonValue> SerializePropertyValueInner(FProperty* Property, const void* Value, TArray<int32>* OutReferencedSubobjects);
+	void WritePropertyValueInner(FProperty* Property, const void* Value, const TSharedRef<FJsonStreamWriter>& Writer, TArray<int32>* OutReferencedSubobjects);
 };